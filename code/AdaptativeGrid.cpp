@@ -1,5 +1,8 @@
 #include "AdaptativeGrid.hpp"
 #include <iostream>
+#include <thread>
+#include <limits>
+#include <queue>
 
 AdaptativeGrid::AdaptativeGrid(const glm::vec3& minBounds, const glm::vec3& maxBounds, int resolution = 10, VoxelizationMethod method = VoxelizationMethod::Optimized)
     : Grid(minBounds, maxBounds, resolution, method)
@@ -12,6 +15,7 @@ AdaptativeGrid::AdaptativeGrid(const std::vector<unsigned short>& indices, const
 {
     if (vertices.empty()) return;
     this->resolution = resolution;
+    this->method = method;
 
     glm::vec3 minVertex = vertices[0];
     glm::vec3 maxVertex = vertices[0];
@@ -31,6 +35,117 @@ AdaptativeGrid::AdaptativeGrid(const std::vector<unsigned short>& indices, const
     Grid::initializeBuffers();
 }
 
+AdaptativeGrid::AdaptativeGrid(const std::vector<unsigned short>& indices, const std::vector<glm::vec3>& vertices, int resolution,
+                               float planarTolerance, size_t nodeBudget)
+{
+    if (vertices.empty()) return;
+    this->resolution = resolution;
+    this->method = VoxelizationMethod::Surface;
+
+    minBounds = vertices[0];
+    maxBounds = vertices[0];
+    for (const auto& vertex : vertices) {
+        minBounds = glm::min(minBounds, vertex);
+        maxBounds = glm::max(maxBounds, vertex);
+    }
+
+    root = std::make_unique<OctreeNode>(minBounds, maxBounds);
+    voxelizeMeshErrorDriven(indices, vertices, planarTolerance, nodeBudget);
+    Grid::initializeBuffers();
+}
+
+AdaptativeGrid::AdaptativeGrid(const OccupancyGrid& occupancy, VoxelizationMethod method)
+{
+    this->method = method;
+    buildFromOccupancy(occupancy);
+    Grid::initializeBuffers();
+}
+
+void AdaptativeGrid::buildFromOccupancy(const OccupancyGrid& occupancy) {
+    // Taille du cube englobant : puissance de 2 supérieure à la plus grande dimension
+    int maxSize = std::max({occupancy.size.x, occupancy.size.y, occupancy.size.z, 1});
+    int depth = 0;
+    while ((1 << depth) < maxSize) ++depth;
+    resolution = depth;
+
+    minBounds = occupancy.minBounds;
+    maxBounds = occupancy.minBounds + glm::vec3(static_cast<float>(1 << depth) * occupancy.voxelSize);
+
+    // Niveau 0 : un bit par voxel, rangé dans l'ordre de Morton pour que
+    // les 8 enfants d'un nœud occupent un octet contigu
+    size_t leafCount = size_t(1) << (3 * depth);
+    std::vector<std::vector<uint64_t>> fullLevels(depth + 1), anyLevels(depth + 1);
+    fullLevels[0].assign((leafCount + 63) / 64, 0);
+
+    size_t i = 0;
+    for (int x = 0; x < occupancy.size.x; ++x) {
+        for (int y = 0; y < occupancy.size.y; ++y) {
+            for (int z = 0; z < occupancy.size.z; ++z, ++i) {
+                if ((occupancy.bits[i >> 6] >> (i & 63)) & 1) {
+                    uint64_t code = Morton::encode(x, y, z);
+                    fullLevels[0][code >> 6] |= 1ull << (code & 63);
+                }
+            }
+        }
+    }
+    anyLevels[0] = fullLevels[0];
+
+    // Fusion niveau par niveau : un parent est plein si ses 8 bits valent 0xFF,
+    // non vide si au moins un bit est levé
+    const uint64_t lowBits = 0x0101010101010101ull;
+    for (int level = 1; level <= depth; ++level) {
+        const std::vector<uint64_t>& fullChildren = fullLevels[level - 1];
+        const std::vector<uint64_t>& anyChildren = anyLevels[level - 1];
+        size_t nodeCount = size_t(1) << (3 * (depth - level));
+        fullLevels[level].assign((nodeCount + 63) / 64, 0);
+        anyLevels[level].assign((nodeCount + 63) / 64, 0);
+
+        for (size_t w = 0; w < fullChildren.size(); ++w) {
+            uint64_t full = fullChildren[w];
+            full &= full >> 1; full &= full >> 2; full &= full >> 4;
+            uint64_t any = anyChildren[w];
+            any |= any >> 1; any |= any >> 2; any |= any >> 4;
+
+            // Regroupe le bit de poids faible de chaque octet en un octet
+            uint64_t fullByte = ((full & lowBits) * 0x0102040810204080ull) >> 56;
+            uint64_t anyByte = ((any & lowBits) * 0x0102040810204080ull) >> 56;
+
+            size_t parent = w * 8;
+            fullLevels[level][parent >> 6] |= fullByte << (parent & 63);
+            anyLevels[level][parent >> 6] |= anyByte << (parent & 63);
+        }
+    }
+
+    root = std::make_unique<OctreeNode>(minBounds, maxBounds);
+    buildNodeFromLevels(*root, fullLevels, anyLevels, depth, 0);
+
+    voxels.clear();
+    fillVoxelDataRecursive(*root);
+    updateFaceMasks();
+    std::cout << "Bottom-up octree built: depth " << depth << ", " << voxels.size() << " leaves." << std::endl;
+}
+
+void AdaptativeGrid::buildNodeFromLevels(OctreeNode& node, const std::vector<std::vector<uint64_t>>& fullLevels,
+                                         const std::vector<std::vector<uint64_t>>& anyLevels, int level, uint64_t code) {
+    bool full = (fullLevels[level][code >> 6] >> (code & 63)) & 1;
+    bool any = (anyLevels[level][code >> 6] >> (code & 63)) & 1;
+
+    // Même convention que voxelizeNode : feuille = pleine, non-feuille sans enfant = vide
+    if (full) {
+        node.isLeaf = true;
+        return;
+    }
+    if (!any || level == 0) {
+        node.isLeaf = false;
+        return;
+    }
+
+    node.subdivide();
+    for (int i = 0; i < 8; ++i) {
+        buildNodeFromLevels(node.children[i], fullLevels, anyLevels, level - 1, (code << 3) | i);
+    }
+}
+
 void AdaptativeGrid::fillVoxelDataRecursive(const OctreeNode& node) {
     if (node.isLeaf) {
         // Créez un VoxelData pour chaque nœud feuille
@@ -90,6 +205,122 @@ void AdaptativeGrid::voxelizeMesh(const std::vector<unsigned short>& indices, co
     voxelizeNode(*root, indices, vertices, resolution);
     voxels.clear();
     fillVoxelDataRecursive(*root);
+    updateFaceMasks();
+}
+
+float AdaptativeGrid::planarityError(const OctreeNode& node, const std::vector<uint32_t>& triangles,
+                                     const std::vector<unsigned short>& indices, const std::vector<glm::vec3>& vertices) const {
+    float halfDiagonal = glm::length(node.maxBounds - node.minBounds) * 0.5f;
+
+    // Plan moyen pondéré par l'aire des triangles du nœud
+    glm::vec3 weightedNormal(0.0f), weightedCentroid(0.0f);
+    float totalArea = 0.0f;
+    for (uint32_t t : triangles) {
+        const glm::vec3& v0 = vertices[indices[t]];
+        const glm::vec3& v1 = vertices[indices[t + 1]];
+        const glm::vec3& v2 = vertices[indices[t + 2]];
+        glm::vec3 crossProduct = glm::cross(v1 - v0, v2 - v0);
+        float area = glm::length(crossProduct) * 0.5f;
+        weightedNormal += crossProduct * 0.5f;
+        weightedCentroid += (v0 + v1 + v2) * (area / 3.0f);
+        totalArea += area;
+    }
+
+    // Normales opposées (feuillets parallèles, arêtes vives) : erreur maximale
+    float normalLength = glm::length(weightedNormal);
+    if (totalArea < LITTLE_EPSILON || normalLength < LITTLE_EPSILON) return halfDiagonal;
+
+    glm::vec3 planeNormal = weightedNormal / normalLength;
+    float planeOffset = glm::dot(planeNormal, weightedCentroid / totalArea);
+
+    // Erreur = max de l'écart angulaire (ramené à la taille du nœud) et de l'écart au plan
+    float error = 0.0f;
+    for (uint32_t t : triangles) {
+        const glm::vec3& v0 = vertices[indices[t]];
+        const glm::vec3& v1 = vertices[indices[t + 1]];
+        const glm::vec3& v2 = vertices[indices[t + 2]];
+        glm::vec3 crossProduct = glm::cross(v1 - v0, v2 - v0);
+        float length = glm::length(crossProduct);
+        if (length < LITTLE_EPSILON) continue;
+
+        float angularError = halfDiagonal * (1.0f - glm::dot(crossProduct / length, planeNormal));
+        float offsetError = std::abs(glm::dot(planeNormal, (v0 + v1 + v2) / 3.0f) - planeOffset);
+        error = std::max(error, std::max(angularError, offsetError));
+    }
+    return error;
+}
+
+void AdaptativeGrid::voxelizeMeshErrorDriven(const std::vector<unsigned short>& indices, const std::vector<glm::vec3>& vertices,
+                                             float planarTolerance, size_t nodeBudget) {
+    struct Candidate {
+        float error;
+        OctreeNode* node;
+        int depth;
+        size_t trianglesSlot;   // Triangles intersectant le nœud dans triangleLists
+        bool operator<(const Candidate& other) const { return error < other.error; }
+    };
+
+    // Chaque nœud ne teste que les triangles de son parent
+    std::vector<std::vector<uint32_t>> triangleLists(1);
+    std::vector<size_t> freeSlots;
+    for (uint32_t t = 0; t + 2 < indices.size(); t += 3) {
+        if (root->intersectsTriangle(vertices[indices[t]], vertices[indices[t + 1]], vertices[indices[t + 2]])) {
+            triangleLists[0].push_back(t);
+        }
+    }
+
+    root->isLeaf = !triangleLists[0].empty();
+    std::priority_queue<Candidate> candidates;
+    if (root->isLeaf && resolution > 1) {
+        candidates.push({planarityError(*root, triangleLists[0], indices, vertices), root.get(), 0, 0});
+    }
+
+    // Raffinement du nœud de plus grande erreur tant que le budget le permet
+    size_t nodeCount = 1;
+    while (!candidates.empty() && nodeCount + 8 <= nodeBudget) {
+        Candidate candidate = candidates.top();
+        if (candidate.error <= planarTolerance) break;
+        candidates.pop();
+
+        std::vector<uint32_t> parentTriangles;
+        parentTriangles.swap(triangleLists[candidate.trianglesSlot]);
+        freeSlots.push_back(candidate.trianglesSlot);
+
+        candidate.node->subdivide();
+        nodeCount += 8;
+        for (auto& child : candidate.node->children) {
+            std::vector<uint32_t> childTriangles;
+            for (uint32_t t : parentTriangles) {
+                if (child.intersectsTriangle(vertices[indices[t]], vertices[indices[t + 1]], vertices[indices[t + 2]])) {
+                    childTriangles.push_back(t);
+                }
+            }
+
+            // Même convention que voxelizeNode : feuille = nœud touché par la surface
+            child.isLeaf = !childTriangles.empty();
+            if (!child.isLeaf || candidate.depth + 2 >= resolution) continue;
+
+            float error = planarityError(child, childTriangles, indices, vertices);
+            if (error <= planarTolerance) continue;
+
+            // Réutilisation des emplacements libérés par les nœuds déjà raffinés
+            size_t slot;
+            if (!freeSlots.empty()) {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+            } else {
+                slot = triangleLists.size();
+                triangleLists.emplace_back();
+            }
+            triangleLists[slot].swap(childTriangles);
+            candidates.push({error, &child, candidate.depth + 1, slot});
+        }
+    }
+
+    voxels.clear();
+    fillVoxelDataRecursive(*root);
+    updateFaceMasks();
+    std::cout << "Error-driven voxelization complete: " << nodeCount << " nodes, " << voxels.size() << " leaves." << std::endl;
 }
 
 void AdaptativeGrid::printGrid() const {
@@ -114,7 +345,7 @@ void AdaptativeGrid::printGrid() const {
     }
 }
 
-void AdaptativeGrid::marchOctreeNode(OctreeNode* node, std::vector<unsigned short>& indices, std::vector<glm::vec3>& vertices) {
+void AdaptativeGrid::marchOctreeNode(OctreeNode* node, std::vector<glm::vec3>& triangles) {
     // Si le nœud est une feuille, on traite sa voxelisations
     if (node->isLeaf) {
         glm::vec3 gridSize = node->maxBounds - node->minBounds;
@@ -164,25 +395,604 @@ void AdaptativeGrid::marchOctreeNode(OctreeNode* node, std::vector<unsigned shor
             int a2 = MarchingCubesTable::cornerIndexAFromEdge[triangulationData[k + 2]];
             int b2 = MarchingCubesTable::cornerIndexBFromEdge[triangulationData[k + 2]];
 
-            // Ajouter les sommets à la liste des vertices
-            vertices.push_back((corners[a] + corners[b]) * 0.5f);
-            vertices.push_back((corners[a1] + corners[b1]) * 0.5f);
-            vertices.push_back((corners[a2] + corners[b2]) * 0.5f);
-
-            // Ajouter les indices des triangles
-            indices.push_back(vertices.size() - 3);
-            indices.push_back(vertices.size() - 2);
-            indices.push_back(vertices.size() - 1);
+            // Sommets du triangle, soudés à la fin du parcours
+            triangles.push_back((corners[a] + corners[b]) * 0.5f);
+            triangles.push_back((corners[a1] + corners[b1]) * 0.5f);
+            triangles.push_back((corners[a2] + corners[b2]) * 0.5f);
         }
     } else {
         // Si ce n'est pas une feuille, subdivisez et traitez les enfants
         for (auto& child : node->children) {
-            marchOctreeNode(&child, indices, vertices);
+            marchOctreeNode(&child, triangles);
         }
     }
 }
 
-void AdaptativeGrid::marchingCube( std::vector<unsigned short> &indices, std::vector<glm::vec3> &vertices) {
+void AdaptativeGrid::marchingCube( std::vector<unsigned int> &indices, std::vector<glm::vec3> &vertices) {
     removeDuplicates(activeCorner);
-    marchOctreeNode(root.get(), indices, vertices);
+    if (!root) return;
+
+    std::vector<glm::vec3> triangles;
+    marchOctreeNode(root.get(), triangles);
+    glm::vec3 extent = root->maxBounds - root->minBounds;
+    weldTriangles(triangles, std::max({extent.x, extent.y, extent.z}) * 1e-5f, indices, vertices);
+}
+
+SparseVoxelDAG AdaptativeGrid::buildDAG() const {
+    if (!root) return SparseVoxelDAG();
+    return SparseVoxelDAG(*root, root->minBounds, root->maxBounds);
+}
+
+bool AdaptativeGrid::raycast(const glm::vec3& origin, const glm::vec3& direction, OctreeRayHit& hit) const {
+    hit = OctreeRayHit();
+    if (!root) return false;
+
+    // On se ramène à une direction positive sur chaque axe en reflétant le rayon
+    // autour du centre de la racine ; le masque permet de retrouver les vrais enfants
+    glm::vec3 o = origin;
+    glm::vec3 d = direction;
+    int mask = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (d[axis] < 0.0f) {
+            o[axis] = root->minBounds[axis] + root->maxBounds[axis] - o[axis];
+            d[axis] = -d[axis];
+            mask |= 1 << axis;
+        }
+        if (d[axis] < LITTLE_EPSILON) d[axis] = LITTLE_EPSILON; // Évite 0 * inf sur les plans de séparation
+    }
+
+    glm::vec3 t0 = (root->minBounds - o) / d;
+    glm::vec3 t1 = (root->maxBounds - o) / d;
+    if (glm::max(glm::max(t0.x, t0.y), t0.z) >= glm::min(glm::min(t1.x, t1.y), t1.z)) return false;
+
+    return raycastNode(*root, t0.x, t0.y, t0.z, t1.x, t1.y, t1.z, mask, hit);
+}
+
+bool AdaptativeGrid::raycastNode(const OctreeNode& node, float tx0, float ty0, float tz0,
+                                 float tx1, float ty1, float tz1, int mask, OctreeRayHit& hit) const {
+    if (tx1 < 0.0f || ty1 < 0.0f || tz1 < 0.0f) return false;
+
+    if (node.children.empty()) {
+        if (!node.isLeaf) return false; // Nœud vide
+        hit.hit = true;
+        hit.t = glm::max(glm::max(glm::max(tx0, ty0), tz0), 0.0f);
+        hit.node = &node;
+        return true;
+    }
+
+    float txm = 0.5f * (tx0 + tx1);
+    float tym = 0.5f * (ty0 + ty1);
+    float tzm = 0.5f * (tz0 + tz1);
+
+    // Premier enfant traversé : selon le plan d'entrée dans le nœud
+    int child = 0;
+    float tEnter = glm::max(glm::max(tx0, ty0), tz0);
+    if (tEnter == tx0) {
+        if (tym < tx0) child |= 2;
+        if (tzm < tx0) child |= 4;
+    } else if (tEnter == ty0) {
+        if (txm < ty0) child |= 1;
+        if (tzm < ty0) child |= 4;
+    } else {
+        if (txm < tz0) child |= 1;
+        if (tym < tz0) child |= 2;
+    }
+
+    // Enfants suivants : on sort par le plan de plus petit t
+    for (;;) {
+        float cx0 = (child & 1) ? txm : tx0, cx1 = (child & 1) ? tx1 : txm;
+        float cy0 = (child & 2) ? tym : ty0, cy1 = (child & 2) ? ty1 : tym;
+        float cz0 = (child & 4) ? tzm : tz0, cz1 = (child & 4) ? tz1 : tzm;
+
+        if (raycastNode(node.children[child ^ mask], cx0, cy0, cz0, cx1, cy1, cz1, mask, hit)) return true;
+
+        if (cx1 <= cy1 && cx1 <= cz1) {
+            if (child & 1) return false;
+            child |= 1;
+        } else if (cy1 <= cz1) {
+            if (child & 2) return false;
+            child |= 2;
+        } else {
+            if (child & 4) return false;
+            child |= 4;
+        }
+    }
+}
+
+void AdaptativeGrid::raycastBatch(const OctreeRay* rays, size_t count, OctreeRayHit* hits, unsigned threadCount) const {
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    threadCount = static_cast<unsigned>(std::min<size_t>(threadCount, std::max<size_t>(1, count / 256)));
+
+    auto processRange = [this, rays, hits](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            raycast(rays[i].origin, rays[i].direction, hits[i]);
+        }
+    };
+
+    if (threadCount <= 1) {
+        processRange(0, count);
+        return;
+    }
+
+    // Découpage en tranches contiguës, le thread appelant traite la dernière
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+    size_t chunk = (count + threadCount - 1) / threadCount;
+    for (unsigned t = 0; t + 1 < threadCount; ++t) {
+        workers.emplace_back(processRange, t * chunk, std::min(count, (t + 1) * chunk));
+    }
+    processRange(std::min(count, (threadCount - 1) * chunk), count);
+    for (auto& worker : workers) worker.join();
+}
+
+bool AdaptativeGrid::containsPoint(const glm::vec3& point) const {
+    if (!root) return false;
+    if (glm::any(glm::lessThan(point, root->minBounds)) || glm::any(glm::greaterThan(point, root->maxBounds))) return false;
+
+    const OctreeNode* node = root.get();
+    while (!node->children.empty()) {
+        glm::vec3 center = (node->minBounds + node->maxBounds) * 0.5f;
+        int child = (point.x >= center.x ? 1 : 0) | (point.y >= center.y ? 2 : 0) | (point.z >= center.z ? 4 : 0);
+        node = &node->children[child];
+    }
+    return node->isLeaf;
+}
+
+bool AdaptativeGrid::overlapsBox(const glm::vec3& boxMin, const glm::vec3& boxMax) const {
+    return root && overlapsBoxNode(*root, boxMin, boxMax);
+}
+
+bool AdaptativeGrid::overlapsBoxNode(const OctreeNode& node, const glm::vec3& boxMin, const glm::vec3& boxMax) const {
+    if (glm::any(glm::lessThan(boxMax, node.minBounds)) || glm::any(glm::greaterThan(boxMin, node.maxBounds))) return false;
+    if (node.children.empty()) return node.isLeaf;
+
+    for (const auto& child : node.children) {
+        if (overlapsBoxNode(child, boxMin, boxMax)) return true;
+    }
+    return false;
+}
+
+const OctreeNode* AdaptativeGrid::nearestLeaf(const glm::vec3& point, float& distance) const {
+    const OctreeNode* bestNode = nullptr;
+    float bestDistance2 = std::numeric_limits<float>::max();
+    if (root) nearestLeafNode(*root, point, bestDistance2, bestNode);
+    distance = bestNode ? std::sqrt(bestDistance2) : std::numeric_limits<float>::max();
+    return bestNode;
+}
+
+void AdaptativeGrid::nearestLeafNode(const OctreeNode& node, const glm::vec3& point,
+                                     float& bestDistance2, const OctreeNode*& bestNode) const {
+    if (node.children.empty()) {
+        if (!node.isLeaf) return;
+        glm::vec3 delta = glm::max(glm::max(node.minBounds - point, point - node.maxBounds), glm::vec3(0.0f));
+        float distance2 = glm::dot(delta, delta);
+        if (distance2 < bestDistance2) {
+            bestDistance2 = distance2;
+            bestNode = &node;
+        }
+        return;
+    }
+
+    // Visite des enfants du plus proche au plus lointain, élagage par distance à la boîte
+    std::pair<float, int> order[8];
+    int count = 0;
+    for (int i = 0; i < static_cast<int>(node.children.size()) && i < 8; ++i) {
+        const OctreeNode& child = node.children[i];
+        if (child.children.empty() && !child.isLeaf) continue;
+        glm::vec3 delta = glm::max(glm::max(child.minBounds - point, point - child.maxBounds), glm::vec3(0.0f));
+        std::pair<float, int> entry(glm::dot(delta, delta), i);
+
+        int k = count++;
+        while (k > 0 && order[k - 1].first > entry.first) {
+            order[k] = order[k - 1];
+            --k;
+        }
+        order[k] = entry;
+    }
+
+    for (int k = 0; k < count; ++k) {
+        if (order[k].first >= bestDistance2) break;
+        nearestLeafNode(node.children[order[k].second], point, bestDistance2, bestNode);
+    }
+}
+
+AdaptativeGrid::~AdaptativeGrid() {
+    deleteLODBuffers();
+}
+
+void AdaptativeGrid::deleteLODBuffers() {
+    if (lodVAO != 0) {
+        glDeleteVertexArrays(1, &lodVAO);
+        glDeleteBuffers(1, &lodVBO);
+        lodVAO = lodVBO = 0;
+    }
+    lodCapacity = 0;
+}
+
+void AdaptativeGrid::resetLOD() {
+    // Emplacements de l'ancien arbre : buffers recréés au prochain updateLOD, feuilles affichées d'ici là
+    deleteLODBuffers();
+    lodSlots.clear();
+    lodFreeSlots.clear();
+    lodData.clear();
+    lodCut.clear();
+    lodLastMVP = glm::mat4(0.0f);
+    lodInstancesDirty = true;
+}
+
+void AdaptativeGrid::selectLODCut(const OctreeNode& node, const glm::mat4& model, const Frustum& frustum, const glm::vec3& cameraPosition,
+                                  float modelScale, float pixelsPerUnit) {
+    // Nœud hors champ : ni lui ni ses descendants n'entrent dans la coupe
+    if (!frustum.intersectsBox(node.minBounds, node.maxBounds)) {
+        ++lodCulledCount;
+        return;
+    }
+
+    if (node.children.empty()) {
+        if (node.isLeaf) lodCut.push_back(&node);
+        return;
+    }
+
+    // Taille projetée approchée à partir de la sphère englobante du nœud
+    glm::vec3 center = glm::vec3(model * glm::vec4((node.minBounds + node.maxBounds) * 0.5f, 1.0f));
+    float radius = glm::length(node.maxBounds - node.minBounds) * 0.5f * modelScale;
+    float distance = glm::length(center - cameraPosition);
+    if (distance > radius && 2.0f * radius * pixelsPerUnit / distance < lodThreshold) {
+        lodCut.push_back(&node); // Nœud affiché comme un seul voxel grossier
+        return;
+    }
+
+    for (const auto& child : node.children) {
+        selectLODCut(child, model, frustum, cameraPosition, modelScale, pixelsPerUnit);
+    }
+}
+
+void AdaptativeGrid::updateLOD(const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection, float viewportHeight) {
+    if (!lodEnabled || !root) return;
+
+    // Rien à faire si ni la caméra, ni l'objet, ni le seuil n'ont changé
+    glm::mat4 mvp = projection * view * model;
+    if (mvp == lodLastMVP && lodThreshold == lodLastThreshold && lodVAO != 0) return;
+    lodLastMVP = mvp;
+    lodLastThreshold = lodThreshold;
+
+    glm::vec3 cameraPosition = glm::vec3(glm::inverse(view)[3]);
+    float modelScale = glm::max(glm::max(glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[1]))),
+                                glm::length(glm::vec3(model[2])));
+    float pixelsPerUnit = projection[1][1] * viewportHeight * 0.5f;
+
+    lodCut.clear();
+    lodCulledCount = 0;
+    selectLODCut(*root, model, Frustum(mvp), cameraPosition, modelScale, pixelsPerUnit); // Plans dans l'espace de la grille
+
+    // Compactage lorsque la moitié des emplacements sont libres
+    if (lodFreeSlots.size() > 1024 && lodFreeSlots.size() * 2 > lodData.size()) {
+        lodSlots.clear();
+        lodFreeSlots.clear();
+        lodData.clear();
+    }
+
+    ++lodFrame;
+    std::vector<GLuint> dirtySlots;
+    std::vector<const OctreeNode*> added;
+    for (const OctreeNode* node : lodCut) {
+        auto it = lodSlots.find(node);
+        if (it != lodSlots.end()) {
+            it->second.frame = lodFrame;
+        } else {
+            added.push_back(node);
+        }
+    }
+
+    // Les nœuds sortis de la coupe libèrent leur emplacement (voxel vide, ignoré par le shader)
+    for (auto it = lodSlots.begin(); it != lodSlots.end();) {
+        if (it->second.frame != lodFrame) {
+            lodData[it->second.slot] = VoxelData(glm::vec3(0.0f), 0.0f, 1, 0);
+            lodFreeSlots.push_back(it->second.slot);
+            dirtySlots.push_back(it->second.slot);
+            it = lodSlots.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (const OctreeNode* node : added) {
+        GLuint slot;
+        if (!lodFreeSlots.empty()) {
+            slot = lodFreeSlots.back();
+            lodFreeSlots.pop_back();
+        } else {
+            slot = static_cast<GLuint>(lodData.size());
+            lodData.emplace_back();
+        }
+        glm::vec3 center = (node->minBounds + node->maxBounds) * 0.5f;
+        glm::vec3 size = (node->maxBounds - node->minBounds) * 0.5f;
+        lodData[slot] = VoxelData(center, size.x, 0, 0);
+        lodSlots[node] = {slot, lodFrame};
+        dirtySlots.push_back(slot);
+    }
+
+    if (!dirtySlots.empty()) lodInstancesDirty = true;
+    uploadLODSlots(dirtySlots);
+}
+
+void AdaptativeGrid::uploadLODSlots(std::vector<GLuint>& dirtySlots) {
+    if (lodVAO == 0) {
+        glGenVertexArrays(1, &lodVAO);
+        glGenBuffers(1, &lodVBO);
+    }
+    glBindVertexArray(lodVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, lodVBO);
+
+    // Réallocation complète uniquement si la capacité est dépassée
+    if (lodData.size() > lodCapacity) {
+        lodCapacity = std::max<size_t>(lodData.size() * 2, 1024);
+        glBufferData(GL_ARRAY_BUFFER, lodCapacity * sizeof(VoxelData), nullptr, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, lodData.size() * sizeof(VoxelData), lodData.data());
+        setupVoxelAttributes();
+    } else if (!dirtySlots.empty()) {
+        // Envoi des seuls emplacements modifiés, regroupés en plages contiguës
+        std::sort(dirtySlots.begin(), dirtySlots.end());
+        dirtySlots.erase(std::unique(dirtySlots.begin(), dirtySlots.end()), dirtySlots.end());
+        size_t begin = 0;
+        while (begin < dirtySlots.size()) {
+            size_t end = begin + 1;
+            while (end < dirtySlots.size() && dirtySlots[end] == dirtySlots[end - 1] + 1) ++end;
+            GLuint first = dirtySlots[begin];
+            glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(VoxelData), (end - begin) * sizeof(VoxelData), &lodData[first]);
+            begin = end;
+        }
+    }
+    glBindVertexArray(0);
+}
+
+void AdaptativeGrid::draw(const Shader& shader, glm::mat4 transformMat) {
+    uploadDirtyVoxels();
+    if (!lodEnabled || lodVAO == 0) {
+        instancesFromLOD = false; // instancesDirty reste vrai : feuilles renvoyées par Grid::draw
+        Grid::draw(shader, transformMat);
+        return;
+    }
+
+    if (instancedRendering) {
+        // Emplacements libres de lodData ignorés : seule la coupe courante est envoyée
+        if (lodInstancesDirty || !instancesFromLOD) {
+            std::vector<VoxelInstance> instances;
+            instances.reserve(lodSlots.size());
+            for (const VoxelData& voxel : lodData) {
+                if (voxel.isEmpty == 0) instances.push_back(makeInstance(voxel));
+            }
+            uploadInstances(instances);
+            lodInstancesDirty = false;
+            instancesFromLOD = true;
+            instancesDirty = true; // instanceData ne correspond plus au contenu de instanceVBO
+        }
+        drawInstances(shader, transformMat);
+        return;
+    }
+
+    glUniformMatrix4fv(shader.getUniformLocation("model"), 1, GL_FALSE, &transformMat[0][0]); // Matrice de transformation
+    glUniform3fv(shader.getUniformLocation("objectColor"), 1, &color[0]); // Couleur
+    glBindVertexArray(lodVAO);
+    glDrawArrays(GL_POINTS, 0, lodData.size());
+    glBindVertexArray(0);
+}
+
+void AdaptativeGrid::updateFaceMasks() {
+    if (!root) return;
+    buildNodeIndex();
+    size_t voxelIndex = 0;
+    updateFaceMasksNode(*root, 1, 0, voxelIndex);
+}
+
+void AdaptativeGrid::updateFaceMasksNode(const OctreeNode& node, uint64_t code, int level, size_t& voxelIndex) {
+    // Même parcours que fillVoxelDataRecursive : les feuilles arrivent dans l'ordre de voxels
+    if (node.isLeaf) {
+        int mask = VOXEL_ALL_FACES;
+        if (level <= Morton::MAX_LOCATIONAL_LEVEL) {
+            for (int face = 0; face < 6; ++face) {
+                // Face cachée si tous les voisins collés à cette face sont des feuilles pleines
+                const OctreeNode* neighbours[4];
+                int count = getFaceNeighbours(code, face, neighbours);
+                bool hidden = count > 0;
+                for (int i = 0; i < count; ++i) hidden = hidden && neighbours[i]->isLeaf;
+                if (hidden) mask &= ~(1 << face);
+            }
+        }
+        if (voxelIndex < voxels.size()) voxels[voxelIndex].faceMask = mask;
+        ++voxelIndex;
+        return;
+    }
+    for (size_t i = 0; i < node.children.size(); ++i) {
+        updateFaceMasksNode(node.children[i], (code << 3) | i, level + 1, voxelIndex);
+    }
+}
+
+void AdaptativeGrid::buildNodeIndex() {
+    nodeIndex.clear();
+    if (root) indexNode(*root, 1, 0);
+}
+
+void AdaptativeGrid::indexNode(OctreeNode& node, uint64_t code, int level) {
+    nodeIndex[code] = &node;
+    if (level >= Morton::MAX_LOCATIONAL_LEVEL) {
+        if (!node.children.empty()) std::cerr << "Octree trop profond pour l'index linéaire (niveau " << level << ")." << std::endl;
+        return;
+    }
+    for (size_t i = 0; i < node.children.size(); ++i) {
+        indexNode(node.children[i], (code << 3) | i, level + 1);
+    }
+}
+
+OctreeNode* AdaptativeGrid::findNode(uint64_t code) const {
+    auto it = nodeIndex.find(code);
+    return it != nodeIndex.end() ? it->second : nullptr;
+}
+
+const OctreeNode* AdaptativeGrid::findFaceNeighbour(uint64_t code, int face) const {
+    uint64_t neighbourCode = Morton::faceNeighbourCode(code, face);
+    if (neighbourCode == 0) return nullptr;
+
+    // Arbre équilibré : le voisin est au même niveau ou un niveau au-dessus,
+    // soit au plus deux recherches dans la table
+    while (neighbourCode > 1) {
+        OctreeNode* neighbour = findNode(neighbourCode);
+        if (neighbour) return neighbour;
+        neighbourCode >>= 3;
+    }
+    return root.get();
+}
+
+int AdaptativeGrid::getFaceNeighbours(uint64_t code, int face, const OctreeNode* neighbours[4]) const {
+    const OctreeNode* neighbour = findFaceNeighbour(code, face);
+    if (!neighbour) return 0;
+    if (neighbour->children.empty()) {
+        neighbours[0] = neighbour;
+        return 1;
+    }
+
+    // Voisin subdivisé : les 4 enfants collés à la face commune
+    int axisBit = 1 << (face / 2);
+    bool nearSideIsHigh = (face & 1) == 0;
+    int count = 0;
+    for (int i = 0; i < 8; ++i) {
+        if (((i & axisBit) != 0) == nearSideIsHigh) neighbours[count++] = &neighbour->children[i];
+    }
+    return count;
+}
+
+void AdaptativeGrid::splitNode(OctreeNode& node, uint64_t code, std::vector<uint64_t>& pending) {
+    // Les enfants héritent de l'occupation de la feuille découpée
+    bool filled = node.isLeaf;
+    node.subdivide();
+    for (size_t i = 0; i < node.children.size(); ++i) {
+        node.children[i].isLeaf = filled;
+        uint64_t childCode = (code << 3) | i;
+        nodeIndex[childCode] = &node.children[i];
+        pending.push_back(childCode);
+    }
+}
+
+void AdaptativeGrid::balance() {
+    if (!root) return;
+    dag.reset();
+    buildNodeIndex();
+
+    std::vector<uint64_t> pending;
+    for (const auto& entry : nodeIndex) {
+        if (entry.second->children.empty()) pending.push_back(entry.first);
+    }
+
+    size_t splitCount = 0;
+    while (!pending.empty()) {
+        uint64_t code = pending.back();
+        pending.pop_back();
+
+        OctreeNode* node = findNode(code);
+        if (!node || !node->children.empty()) continue;
+        int level = Morton::locationalLevel(code);
+        if (level < 2) continue;
+
+        for (int face = 0; face < 6; ++face) {
+            uint64_t neighbourCode = Morton::faceNeighbourCode(code, face);
+            if (neighbourCode == 0) continue;
+
+            // Plus proche ancêtre existant du voisin de même niveau
+            uint64_t ancestorCode = neighbourCode >> 3;
+            OctreeNode* ancestor = findNode(ancestorCode);
+            while (!ancestor && ancestorCode > 1) {
+                ancestorCode >>= 3;
+                ancestor = findNode(ancestorCode);
+            }
+
+            // Feuille voisine trop grossière : on la découpe et on revérifie
+            if (ancestor && ancestor->children.empty() && Morton::locationalLevel(ancestorCode) < level - 1) {
+                splitNode(*ancestor, ancestorCode, pending);
+                pending.push_back(code);
+                ++splitCount;
+                break;
+            }
+        }
+    }
+
+    voxels.clear();
+    fillVoxelDataRecursive(*root);
+    updateFaceMasks();
+    resetLOD();
+    Grid::initializeBuffers();
+    std::cout << "2:1 balancing complete: " << splitCount << " splits, " << voxels.size() << " leaves." << std::endl;
+}
+
+void AdaptativeGrid::serializeOctree(std::vector<uint8_t>& codes, uint64_t& nodeCount) const {
+    codes.clear();
+    nodeCount = 0;
+    if (!root) return;
+
+    // Parcours en pré-ordre avec une pile explicite, enfants dans l'ordre 0..7
+    std::vector<const OctreeNode*> stack = {root.get()};
+    while (!stack.empty()) {
+        const OctreeNode* node = stack.back();
+        stack.pop_back();
+
+        uint8_t code = node->isLeaf ? 1 : (node->children.empty() ? 0 : 2);
+        if ((nodeCount & 3) == 0) codes.push_back(0);
+        codes.back() |= code << ((nodeCount & 3) * 2);
+        ++nodeCount;
+
+        if (code == 2) {
+            for (int i = static_cast<int>(node->children.size()) - 1; i >= 0; --i) {
+                stack.push_back(&node->children[i]);
+            }
+        }
+    }
+}
+
+bool AdaptativeGrid::restoreNode(OctreeNode& node, const uint8_t* codes, uint64_t nodeCount, uint64_t& cursor, int depth) {
+    if (cursor >= nodeCount || depth > Morton::MAX_LOCATIONAL_LEVEL) return false;
+
+    uint8_t code = (codes[cursor >> 2] >> ((cursor & 3) * 2)) & 3;
+    ++cursor;
+    switch (code) {
+        case 0:
+            node.isLeaf = false;
+            return true;
+        case 1:
+            node.isLeaf = true;
+            return true;
+        case 2:
+            // Les bornes des enfants sont recalculées exactement comme à la subdivision d'origine
+            node.subdivide();
+            for (auto& child : node.children) {
+                if (!restoreNode(child, codes, nodeCount, cursor, depth + 1)) return false;
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool AdaptativeGrid::restore(const glm::vec3& minBounds, const glm::vec3& maxBounds, int resolution,
+                             VoxelizationMethod method, const uint8_t* codes, uint64_t nodeCount, bool uploadBuffers) {
+    this->minBounds = minBounds;
+    this->maxBounds = maxBounds;
+    this->resolution = resolution;
+    this->method = method;
+
+    dag.reset();
+    root = std::make_unique<OctreeNode>(minBounds, maxBounds);
+    uint64_t cursor = 0;
+    if (!restoreNode(*root, codes, nodeCount, cursor, 0) || cursor != nodeCount) {
+        std::cerr << "Erreur : octree linéaire corrompu (" << cursor << " / " << nodeCount << " nœuds lus)." << std::endl;
+        root = std::make_unique<OctreeNode>(minBounds, maxBounds);
+        return false;
+    }
+
+    voxels.clear();
+    fillVoxelDataRecursive(*root);
+    updateFaceMasks();
+    nodeIndex.clear();
+    resetLOD();
+    if (uploadBuffers) Grid::initializeBuffers();
+    std::cout << "Octree restored: " << nodeCount << " nodes, " << voxels.size() << " leaves." << std::endl;
+    return true;
 }
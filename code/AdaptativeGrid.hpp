@@ -3,6 +3,9 @@
 
 #include <memory>
 #include "Grid.hpp"
+#include "SparseVoxelDAG.hpp"
+#include "Morton.hpp"
+#include "Frustum.hpp"
 
 struct OctreeNode {
     glm::vec3 minBounds, maxBounds;     // Limites du nœud
@@ -102,26 +105,127 @@ struct OctreeNode {
     
 };
 
+struct OctreeRay {
+    glm::vec3 origin;
+    glm::vec3 direction;
+};
+
+struct OctreeRayHit {
+    bool hit = false;
+    float t = 0.0f;                     // Distance paramétrique le long du rayon
+    const OctreeNode* node = nullptr;   // Feuille touchée
+};
+
 class AdaptativeGrid : public Grid {
 private:
     std::shared_ptr<OctreeNode> root;
+    std::unique_ptr<SparseVoxelDAG> dag;    // Dernière compression de root, supprimée dès que l'arbre change
     
+    // Parcours paramétrique (Revelles et al.) : mask = axes dont la direction a été inversée
+    bool raycastNode(const OctreeNode& node, float tx0, float ty0, float tz0,
+                     float tx1, float ty1, float tz1, int mask, OctreeRayHit& hit) const;
+    void nearestLeafNode(const OctreeNode& node, const glm::vec3& point,
+                         float& bestDistance2, const OctreeNode*& bestNode) const;
+    bool overlapsBoxNode(const OctreeNode& node, const glm::vec3& boxMin, const glm::vec3& boxMax) const;
+
+    // LOD : coupe de l'octree dépendante de la vue, stockée dans un VBO à emplacements fixes
+    struct LODSlot {
+        GLuint slot;        // Emplacement dans lodVBO
+        uint32_t frame;     // Dernière frame où le nœud appartenait à la coupe
+    };
+    bool lodEnabled = false;
+    float lodThreshold = 8.0f;                                  // Taille projetée (pixels) sous laquelle un nœud n'est plus raffiné
+    GLuint lodVAO = 0, lodVBO = 0;
+    size_t lodCapacity = 0;                                     // Nombre d'emplacements alloués dans lodVBO
+    uint32_t lodFrame = 0;
+    std::vector<VoxelData> lodData;                             // Copie CPU du contenu de lodVBO
+    std::vector<GLuint> lodFreeSlots;
+    std::unordered_map<const OctreeNode*, LODSlot> lodSlots;
+    std::vector<const OctreeNode*> lodCut;                      // Coupe calculée à la frame courante
+    glm::mat4 lodLastMVP {0.0f};
+    float lodLastThreshold = 0.0f;
+    bool lodInstancesDirty = true;                              // Coupe modifiée depuis le dernier envoi des instances
+    bool instancesFromLOD = false;                              // Le buffer d'instances contient la coupe, pas les feuilles
+    size_t lodCulledCount = 0;                                  // Nœuds hors champ écartés de la coupe
+
+    // Octree linéaire : code de localisation -> nœud, pour les requêtes de voisinage
+    std::unordered_map<uint64_t, OctreeNode*> nodeIndex;
+    void indexNode(OctreeNode& node, uint64_t code, int level);
+    void splitNode(OctreeNode& node, uint64_t code, std::vector<uint64_t>& pending);
+    bool restoreNode(OctreeNode& node, const uint8_t* codes, uint64_t nodeCount, uint64_t& cursor, int depth);
+
+    void selectLODCut(const OctreeNode& node, const glm::mat4& model, const Frustum& frustum, const glm::vec3& cameraPosition,
+                      float modelScale, float pixelsPerUnit);
+    void uploadLODSlots(std::vector<GLuint>& dirtySlots);
+    void deleteLODBuffers();
+
 
 public:
     AdaptativeGrid() {};
     AdaptativeGrid(const glm::vec3& minBounds, const glm::vec3& maxBounds, int resolution, VoxelizationMethod method);
     AdaptativeGrid(const std::vector<unsigned short>& indices, const std::vector<glm::vec3>& vertices, int resolution, VoxelizationMethod method);
+    // Subdivision guidée par l'erreur de planéité, limitée à nodeBudget nœuds
+    AdaptativeGrid(const std::vector<unsigned short>& indices, const std::vector<glm::vec3>& vertices, int resolution,
+                   float planarTolerance, size_t nodeBudget);
+    // Construction ascendante depuis une grille d'occupation (sans test triangle / boîte)
+    AdaptativeGrid(const OccupancyGrid& occupancy, VoxelizationMethod method = VoxelizationMethod::Optimized);
 
     void printGrid() const;
 
     void voxelizeMesh(const std::vector<unsigned short>& indices, const std::vector<glm::vec3>& vertices);
     void voxelizeNode(OctreeNode& node, const std::vector<unsigned short>& indices,
                     const std::vector<glm::vec3>& vertices, int depth);
+    void voxelizeMeshErrorDriven(const std::vector<unsigned short>& indices, const std::vector<glm::vec3>& vertices,
+                                 float planarTolerance, size_t nodeBudget);
+    float planarityError(const OctreeNode& node, const std::vector<uint32_t>& triangles,
+                         const std::vector<unsigned short>& indices, const std::vector<glm::vec3>& vertices) const;
     void fillVoxelDataRecursive(const OctreeNode& node);
-    void marchingCube( std::vector<unsigned short> &indices, std::vector<glm::vec3> &vertices) override;
-    void marchOctreeNode(OctreeNode* node, std::vector<unsigned short>& indices, std::vector<glm::vec3>& vertices);
-
-    virtual ~AdaptativeGrid() = default;
+    void updateFaceMasksNode(const OctreeNode& node, uint64_t code, int level, size_t& voxelIndex);
+    void buildFromOccupancy(const OccupancyGrid& occupancy);
+    void buildNodeFromLevels(OctreeNode& node, const std::vector<std::vector<uint64_t>>& fullLevels,
+                             const std::vector<std::vector<uint64_t>>& anyLevels, int level, uint64_t code);
+    void marchingCube( std::vector<unsigned int> &indices, std::vector<glm::vec3> &vertices) override;
+    void marchOctreeNode(OctreeNode* node, std::vector<glm::vec3>& triangles);
+
+    // Compression de l'octree en graphe orienté acyclique (sous-arbres identiques partagés)
+    SparseVoxelDAG buildDAG() const;
+    // Compression conservée avec la grille : une nouvelle voxelisation crée une autre grille, sans DAG
+    const SparseVoxelDAG& compressDAG() { dag = std::make_unique<SparseVoxelDAG>(buildDAG()); return *dag; }
+    const SparseVoxelDAG* getDAG() const { return dag.get(); }
+    const OctreeNode* getRoot() const { return root.get(); }
+
+    // Octree linéaire en pré-ordre, 2 bits par nœud (0 vide, 1 feuille pleine, 2 interne),
+    // utilisé par VoxelGridFile
+    void serializeOctree(std::vector<uint8_t>& codes, uint64_t& nodeCount) const;
+    bool restore(const glm::vec3& minBounds, const glm::vec3& maxBounds, int resolution,
+                 VoxelizationMethod method, const uint8_t* codes, uint64_t nodeCount, bool uploadBuffers = true);
+
+    // Requêtes spatiales sans allocation, utilisables depuis plusieurs threads
+    bool raycast(const glm::vec3& origin, const glm::vec3& direction, OctreeRayHit& hit) const;
+    void raycastBatch(const OctreeRay* rays, size_t count, OctreeRayHit* hits, unsigned threadCount = 0) const;
+    bool containsPoint(const glm::vec3& point) const;
+    bool overlapsBox(const glm::vec3& boxMin, const glm::vec3& boxMax) const;
+    const OctreeNode* nearestLeaf(const glm::vec3& point, float& distance) const;
+
+    // Équilibrage 2:1 et voisinage par arithmétique de Morton
+    void buildNodeIndex();   // À rappeler après toute modification de l'arbre
+    void updateFaceMasks();  // Faces des feuilles cachées par des feuilles pleines voisines
+    void balance();          // Aucune feuille adjacente à une feuille de plus d'un niveau d'écart
+    OctreeNode* findNode(uint64_t code) const;
+    const OctreeNode* findFaceNeighbour(uint64_t code, int face) const;
+    int getFaceNeighbours(uint64_t code, int face, const OctreeNode* neighbours[4]) const;
+    const std::unordered_map<uint64_t, OctreeNode*>& getNodeIndex() const { return nodeIndex; }
+
+    // Niveau de détail dépendant de la vue
+    void updateLOD(const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection, float viewportHeight) override;
+    void draw(const Shader& shader, glm::mat4 transformMat = glm::mat4(1.0f)) override;
+    void resetLOD();
+    bool& isLODEnabled() { return lodEnabled; }
+    float& getLODThreshold() { return lodThreshold; }
+    size_t getLODVoxelCount() const { return lodSlots.size(); }
+    size_t getCulledBrickCount() const override { return lodEnabled ? lodCulledCount : 0; }
+
+    virtual ~AdaptativeGrid();
 };
 
 #endif
@@ -0,0 +1,356 @@
+#include "AssetIndex.hpp"
+#include "AdaptativeGrid.hpp"
+#include "MappedFile.hpp"
+#include "MeshCache.hpp"
+#include "stb_image.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <unordered_set>
+
+namespace {
+    const char* INDEX_HEADER = "# asset index v1";
+
+    // Coûts unitaires mesurés sur les voxeliseurs de RegularGrid / AdaptativeGrid (secondes)
+    const double RAY_TRIANGLE_TEST = 1.1e-8;
+    const double BOX_TRIANGLE_TEST = 3.5e-8;
+    const double VOXEL_SETUP = 1.5e-7;
+
+    std::string canonicalPath(const std::string& path) {
+        std::error_code error;
+        std::string key = std::filesystem::weakly_canonical(path, error).string();
+        return error ? path : key;
+    }
+
+    std::string lowerExtension(const std::filesystem::path& path) {
+        std::string extension = path.extension().string();
+        for (char& c : extension) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        return extension;
+    }
+
+    bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    const char* skipLine(const char* p, const char* end) {
+        while (p < end && *p != '\n') ++p;
+        return p < end ? p + 1 : end;
+    }
+
+    // Espaces, sauts de ligne et commentaires
+    const char* skipBlank(const char* p, const char* end) {
+        while (p < end) {
+            if (isSpace(*p)) ++p;
+            else if (*p == '#') p = skipLine(p, end);
+            else break;
+        }
+        return p;
+    }
+
+    template <typename T>
+    bool readNumber(const char*& p, const char* end, T& value) {
+        p = skipBlank(p, end);
+        auto result = std::from_chars(p, end, value);
+        if (result.ec != std::errc()) return false;
+        p = result.ptr;
+        return true;
+    }
+
+    bool readOFFInfo(const char* p, const char* end, AssetInfo& info) {
+        // Mot-clé (OFF, COFF, NOFF...) puis nombres de sommets, faces, arêtes
+        p = skipBlank(p, end);
+        const char* keyword = p;
+        while (p < end && !isSpace(*p)) ++p;
+        if (p - keyword < 3 || std::string(p - 3, p) != "OFF") return false;
+
+        uint32_t vertexCount, faceCount;
+        if (!readNumber(p, end, vertexCount) || !readNumber(p, end, faceCount)) return false;
+        p = skipLine(p, end);
+
+        // Boîte englobante : seuls les sommets sont lus, pas les faces
+        info.vertexCount = vertexCount;
+        info.faceCount = faceCount;
+        info.minBounds = glm::vec3(std::numeric_limits<float>::max());
+        info.maxBounds = glm::vec3(std::numeric_limits<float>::lowest());
+        for (uint32_t v = 0; v < vertexCount; ++v) {
+            glm::vec3 position;
+            if (!readNumber(p, end, position.x) || !readNumber(p, end, position.y) || !readNumber(p, end, position.z)) return false;
+            info.minBounds = glm::min(info.minBounds, position);
+            info.maxBounds = glm::max(info.maxBounds, position);
+            p = skipLine(p, end);
+        }
+        if (vertexCount == 0) info.minBounds = info.maxBounds = glm::vec3(0.0f);
+        return true;
+    }
+
+    bool readOBJInfo(const char* p, const char* end, AssetInfo& info) {
+        // Pas d'en-tête en OBJ : un seul passage sur les lignes v et f
+        info.minBounds = glm::vec3(std::numeric_limits<float>::max());
+        info.maxBounds = glm::vec3(std::numeric_limits<float>::lowest());
+        while (p < end) {
+            while (p < end && (*p == ' ' || *p == '\t')) ++p;
+            if (end - p > 1 && p[0] == 'v' && (p[1] == ' ' || p[1] == '\t')) {
+                const char* q = p + 2;
+                glm::vec3 position;
+                if (readNumber(q, end, position.x) && readNumber(q, end, position.y) && readNumber(q, end, position.z)) {
+                    info.minBounds = glm::min(info.minBounds, position);
+                    info.maxBounds = glm::max(info.maxBounds, position);
+                    ++info.vertexCount;
+                }
+            } else if (end - p > 1 && p[0] == 'f' && (p[1] == ' ' || p[1] == '\t')) {
+                ++info.faceCount;
+            }
+            p = skipLine(p, end);
+        }
+        if (info.vertexCount == 0) info.minBounds = info.maxBounds = glm::vec3(0.0f);
+        return info.vertexCount > 0;
+    }
+}
+
+AssetIndex& AssetIndex::instance() {
+    static AssetIndex index;
+    return index;
+}
+
+bool AssetIndex::readMeshInfo(const std::string& path, AssetInfo& info) {
+    info.kind = AssetInfo::MeshAsset;
+
+    // Cache binaire à jour : tout est déjà dans son en-tête
+    MeshCache cache;
+    if (cache.open(path)) {
+        info.vertexCount = static_cast<uint32_t>(cache.getVertexCount());
+        info.faceCount = static_cast<uint32_t>(cache.getIndexCount() / 3);
+        info.minBounds = cache.getMinBounds();
+        info.maxBounds = cache.getMaxBounds();
+        return true;
+    }
+
+    MappedFile file(path);
+    if (!file.isOpen()) return false;
+    std::string extension = lowerExtension(path);
+    if (extension == ".off") return readOFFInfo(file.begin(), file.end(), info);
+    if (extension == ".obj") return readOBJInfo(file.begin(), file.end(), info);
+    return false;
+}
+
+bool AssetIndex::readTextureInfo(const std::string& path, AssetInfo& info) {
+    info.kind = AssetInfo::TextureAsset;
+    return stbi_info(path.c_str(), &info.width, &info.height, &info.channels) != 0;
+}
+
+void AssetIndex::startScan(const std::vector<std::string>& directories, const std::string& indexFile) {
+    if (isScanning()) return;
+    scanTask = std::async(std::launch::async, [this, directories, indexFile]() { scan(directories, indexFile); });
+}
+
+bool AssetIndex::isScanning() const {
+    return scanTask.valid() && scanTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+void AssetIndex::scan(const std::vector<std::string>& directories, const std::string& indexFile) {
+    auto start = std::chrono::steady_clock::now();
+    loadIndexFile(indexFile);
+
+    size_t readCount = 0, reusedCount = 0;
+    std::unordered_set<std::string> seen;
+    for (const std::string& directory : directories) {
+        std::error_code error;
+        for (std::filesystem::recursive_directory_iterator it(directory, error), last; it != last; it.increment(error)) {
+            if (error || !it->is_regular_file(error)) continue;
+
+            std::string extension = lowerExtension(it->path());
+            AssetInfo info;
+            if (extension == ".off" || extension == ".obj") info.kind = AssetInfo::MeshAsset;
+            else if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp") info.kind = AssetInfo::TextureAsset;
+            else continue;
+
+            info.path = canonicalPath(it->path().string());
+            info.fileSize = it->file_size(error);
+            info.modificationTime = static_cast<int64_t>(it->last_write_time(error).time_since_epoch().count());
+            seen.insert(info.path);
+
+            // Fichier inchangé depuis la dernière indexation
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto found = assets.find(info.path);
+                if (found != assets.end() && found->second.fileSize == info.fileSize
+                    && found->second.modificationTime == info.modificationTime) {
+                    ++reusedCount;
+                    continue;
+                }
+            }
+
+            bool valid = (info.kind == AssetInfo::MeshAsset) ? readMeshInfo(info.path, info) : readTextureInfo(info.path, info);
+            if (!valid) continue;
+            std::lock_guard<std::mutex> lock(mutex);
+            assets[info.path] = info;
+            ++readCount;
+        }
+    }
+
+    // Fichiers supprimés depuis
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = assets.begin(); it != assets.end();) {
+            if (seen.count(it->first)) ++it;
+            else it = assets.erase(it);
+        }
+    }
+
+    saveIndexFile(indexFile);
+    float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Asset index: " << seen.size() << " assets (" << readCount << " read, " << reusedCount
+              << " from " << indexFile << ") in " << elapsed << " ms" << std::endl;
+}
+
+bool AssetIndex::loadIndexFile(const std::string& indexFile) {
+    std::ifstream inFile(indexFile);
+    std::string line;
+    if (!inFile || !std::getline(inFile, line) || line != INDEX_HEADER) return false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    while (std::getline(inFile, line)) {
+        // Chemin en premier champ (peut contenir des espaces), séparé par une tabulation
+        size_t tab = line.find('\t');
+        if (tab == std::string::npos) continue;
+
+        AssetInfo info;
+        info.path = line.substr(0, tab);
+        std::istringstream fields(line.substr(tab + 1));
+        int kind;
+        fields >> kind >> info.fileSize >> info.modificationTime >> info.vertexCount >> info.faceCount
+               >> info.minBounds.x >> info.minBounds.y >> info.minBounds.z
+               >> info.maxBounds.x >> info.maxBounds.y >> info.maxBounds.z
+               >> info.width >> info.height >> info.channels;
+        if (!fields) continue;
+        info.kind = static_cast<AssetInfo::Kind>(kind);
+        assets[info.path] = info;
+    }
+    return true;
+}
+
+bool AssetIndex::saveIndexFile(const std::string& indexFile) const {
+    std::ofstream outFile(indexFile);
+    if (!outFile) {
+        std::cerr << "Erreur : impossible d'écrire l'index des assets " << indexFile << std::endl;
+        return false;
+    }
+
+    outFile << INDEX_HEADER << "\n";
+    outFile.precision(9);
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& item : assets) {
+        const AssetInfo& info = item.second;
+        outFile << info.path << '\t' << static_cast<int>(info.kind) << ' ' << info.fileSize << ' ' << info.modificationTime << ' '
+                << info.vertexCount << ' ' << info.faceCount << ' '
+                << info.minBounds.x << ' ' << info.minBounds.y << ' ' << info.minBounds.z << ' '
+                << info.maxBounds.x << ' ' << info.maxBounds.y << ' ' << info.maxBounds.z << ' '
+                << info.width << ' ' << info.height << ' ' << info.channels << "\n";
+    }
+    return static_cast<bool>(outFile);
+}
+
+bool AssetIndex::find(const std::string& path, AssetInfo& info) const {
+    std::string key = canonicalPath(path);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = assets.find(key);
+    if (found == assets.end()) return false;
+    info = found->second;
+    return true;
+}
+
+size_t AssetIndex::getAssetCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return assets.size();
+}
+
+VoxelizationEstimate AssetIndex::estimateVoxelization(const glm::vec3& minBounds, const glm::vec3& maxBounds, size_t triangleCount,
+                                                      int resolution, VoxelizationMethod method, bool adaptative) {
+    VoxelizationEstimate estimate;
+    glm::vec3 extent = maxBounds - minBounds;
+    if (resolution <= 0) return estimate;
+    double triangles = static_cast<double>(triangleCount);
+
+    if (adaptative) {
+        // La résolution est la profondeur de l'octree : cellules occupées par niveau
+        // bornées par le plein (8^l) et par une surface fermée typique (3 * 4^l)
+        int depth = std::min(resolution, 20);
+        double visited = 1.0, occupied = 1.0;
+        for (int level = 1; level < depth; ++level) {
+            visited += 8.0 * occupied;
+            occupied = std::min(std::pow(8.0, level), 3.0 * std::pow(4.0, level));
+        }
+        estimate.gridSize = glm::ivec3(1 << (depth - 1));
+        estimate.voxelCount = static_cast<size_t>(occupied);
+        estimate.memoryBytes = static_cast<size_t>(visited * sizeof(OctreeNode) + occupied * sizeof(VoxelData) * 2);
+        // Un nœud vide teste tous les triangles, mais la plupart des nœuds touchés s'arrêtent très tôt
+        estimate.seconds = static_cast<float>(visited * triangles * 0.15 * BOX_TRIANGLE_TEST);
+        return estimate;
+    }
+
+    // Même découpage que RegularGrid::generateVoxels
+    float voxelSize = std::min({extent.x / resolution, extent.y / resolution, extent.z / resolution});
+    if (!(voxelSize > 0.0f)) return estimate;
+    estimate.gridSize = glm::ivec3(glm::ceil(extent / voxelSize));
+    double x = estimate.gridSize.x, y = estimate.gridSize.y, z = estimate.gridSize.z;
+    double cells = x * y * z;
+    double columns = x * y + y * z + x * z;
+
+    estimate.voxelCount = static_cast<size_t>(cells);
+    double filled = (method == VoxelizationMethod::Surface) ? std::min(cells, 2.0 * columns) : cells * 0.5;
+    // Voxels côté CPU et copie GPU, 8 coins actifs par voxel plein
+    estimate.memoryBytes = static_cast<size_t>(cells * sizeof(VoxelData) * 2 + filled * 8 * sizeof(glm::vec3));
+
+    switch (method) {
+        case VoxelizationMethod::Simple:
+            estimate.seconds = static_cast<float>(cells * triangles * RAY_TRIANGLE_TEST);
+            break;
+        case VoxelizationMethod::Optimized:
+            estimate.seconds = static_cast<float>(columns * triangles * RAY_TRIANGLE_TEST);
+            break;
+        case VoxelizationMethod::Surface:
+            estimate.seconds = static_cast<float>(triangles * 8.0 * BOX_TRIANGLE_TEST + cells * VOXEL_SETUP);
+            break;
+    }
+    return estimate;
+}
+
+void AssetIndex::drawAssetInfo(const std::string& path) {
+    if (path.empty()) return;
+
+    AssetInfo info;
+    if (!instance().find(path, info)) {
+        ImGui::TextDisabled(instance().isScanning() ? "Indexation en cours..." : "Pas d'information sur ce fichier");
+        return;
+    }
+
+    if (info.kind == AssetInfo::MeshAsset) {
+        glm::vec3 size = info.maxBounds - info.minBounds;
+        ImGui::Text("%u sommets, %u faces", info.vertexCount, info.faceCount);
+        ImGui::Text("Boîte : %.3g x %.3g x %.3g", size.x, size.y, size.z);
+    } else {
+        ImGui::Text("%d x %d, %d canaux", info.width, info.height, info.channels);
+    }
+    ImGui::Text("Fichier : %.1f Ko", info.fileSize / 1024.0);
+}
+
+void AssetIndex::fileDialogPane(const char* /*filter*/, IGFD::UserDatas /*userDatas*/, bool* /*cantContinue*/) {
+    ImGui::Text("Informations");
+    ImGui::Separator();
+    std::map<std::string, std::string> selection = ImGuiFileDialog::Instance()->GetSelection();
+    if (selection.empty()) {
+        ImGui::TextDisabled("Aucun fichier sélectionné");
+        return;
+    }
+    for (const auto& file : selection) {
+        ImGui::TextUnformatted(file.first.c_str());
+        drawAssetInfo(file.second);
+        ImGui::Separator();
+    }
+}
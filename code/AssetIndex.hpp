@@ -0,0 +1,80 @@
+#ifndef ASSET_INDEX_HPP__
+#define ASSET_INDEX_HPP__
+
+#include <string>
+#include <vector>
+#include <future>
+#include <mutex>
+#include <cstdint>
+#include <unordered_map>
+#include <glm/glm.hpp>
+#include <imgui/ImGuiFileDialog.h>
+
+#include "Grid.hpp"
+
+// Métadonnées d'un fichier du dossier data, lues sans charger le contenu
+struct AssetInfo {
+    enum Kind : int { MeshAsset = 0, TextureAsset = 1 };
+
+    Kind kind = MeshAsset;
+    std::string path;                   // Chemin canonique
+    uint64_t fileSize = 0;
+    int64_t modificationTime = 0;
+
+    // Maillages
+    uint32_t vertexCount = 0;
+    uint32_t faceCount = 0;
+    glm::vec3 minBounds {0.f};
+    glm::vec3 maxBounds {0.f};
+
+    // Images
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+};
+
+// Estimation du coût d'une voxelisation, avant de la lancer
+struct VoxelizationEstimate {
+    glm::ivec3 gridSize {0, 0, 0};
+    size_t voxelCount = 0;      // Voxels de la grille régulière, ou feuilles estimées de l'octree
+    size_t memoryBytes = 0;     // CPU + GPU
+    float seconds = 0.f;
+};
+
+// Index des assets (maillages et textures), construit sur un thread de travail
+// et conservé sur disque : seuls les fichiers modifiés depuis sont relus.
+class AssetIndex {
+private:
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, AssetInfo> assets;
+    std::future<void> scanTask;
+
+    AssetIndex() {}
+    void scan(const std::vector<std::string>& directories, const std::string& indexFile);
+    bool loadIndexFile(const std::string& indexFile);
+    bool saveIndexFile(const std::string& indexFile) const;
+
+public:
+    static AssetIndex& instance();
+
+    AssetIndex(const AssetIndex&) = delete;
+    AssetIndex& operator=(const AssetIndex&) = delete;
+
+    void startScan(const std::vector<std::string>& directories, const std::string& indexFile);
+    bool isScanning() const;
+    bool find(const std::string& path, AssetInfo& info) const;
+    size_t getAssetCount() const;
+
+    // Lecture des seuls en-têtes (ou du cache .meshcache quand il est à jour)
+    static bool readMeshInfo(const std::string& path, AssetInfo& info);
+    static bool readTextureInfo(const std::string& path, AssetInfo& info);
+
+    static VoxelizationEstimate estimateVoxelization(const glm::vec3& minBounds, const glm::vec3& maxBounds, size_t triangleCount,
+                                                     int resolution, VoxelizationMethod method, bool adaptative);
+
+    // Affichage ImGui des métadonnées, et panneau latéral des dialogues de fichiers
+    static void drawAssetInfo(const std::string& path);
+    static void fileDialogPane(const char* filter, IGFD::UserDatas userDatas, bool* cantContinue);
+};
+
+#endif
@@ -0,0 +1,182 @@
+#include "BatchRenderer.hpp"
+
+bool BatchRenderer::enabled = true;
+
+BatchRenderer::~BatchRenderer() {
+    if (VAO != 0) {
+        glDeleteVertexArrays(1, &VAO);
+        glDeleteBuffers(1, &vertexVBO);
+        glDeleteBuffers(1, &indexVBO);
+        glDeleteBuffers(1, &drawIdVBO);
+        glDeleteBuffers(1, &indirectBuffer);
+        glDeleteBuffers(1, &objectBuffer);
+        glDeleteTextures(1, &objectTexture);
+    }
+}
+
+// Même suite d'objets (avec indices) et mêmes sommets que lors de la dernière construction
+bool BatchRenderer::rangesMatch(const std::vector<std::unique_ptr<GameObject>>& objects) const {
+    size_t r = 0;
+    for (const auto& object : objects) {
+        if (object->getIndexCount() == 0) continue;
+        if (r >= ranges.size() || ranges[r].object != object.get() || ranges[r].meshVersion != object->getMeshVersion()) {
+            return false;
+        }
+        ++r;
+    }
+    return r == ranges.size();
+}
+
+void BatchRenderer::rebuildArena(const std::vector<std::unique_ptr<GameObject>>& objects) {
+    if (VAO == 0) {
+        // Le contexte existe : on peut interroger les extensions
+        multiDrawIndirect = GLEW_ARB_multi_draw_indirect && GLEW_ARB_base_instance;
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &vertexVBO);
+        glGenBuffers(1, &indexVBO);
+        glGenBuffers(1, &drawIdVBO);
+        glGenBuffers(1, &indirectBuffer);
+        glGenBuffers(1, &objectBuffer);
+        glGenTextures(1, &objectTexture);
+
+        glBindTexture(GL_TEXTURE_BUFFER, objectTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, objectBuffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    }
+
+    // Concaténation : les indices 16 bits restent relatifs à leur mesh grâce à baseVertex
+    std::vector<PackedVertex> vertices;
+    std::vector<unsigned short> indices;
+    ranges.clear();
+    for (const auto& object : objects) {
+        if (object->getIndexCount() == 0) continue;
+        std::vector<PackedVertex> packed = object->getPackedVertices();
+        const std::vector<unsigned short>& meshIndices = object->getIndexData();
+
+        MeshRange range;
+        range.object = object.get();
+        range.meshVersion = object->getMeshVersion();
+        range.firstIndex = static_cast<GLuint>(indices.size());
+        range.indexCount = static_cast<GLuint>(meshIndices.size());
+        range.baseVertex = static_cast<GLint>(vertices.size());
+        ranges.push_back(range);
+
+        vertices.insert(vertices.end(), packed.begin(), packed.end());
+        indices.insert(indices.end(), meshIndices.begin(), meshIndices.end());
+    }
+
+    glBindVertexArray(VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vertexVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(PackedVertex) * vertices.size(), vertices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(PackedVertex), (void *)offsetof(PackedVertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex), (void *)offsetof(PackedVertex, uv));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 2, GL_SHORT, GL_TRUE, sizeof(PackedVertex), (void *)offsetof(PackedVertex, normal));
+    glEnableVertexAttribArray(2);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexVBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned short) * indices.size(), indices.data(), GL_STATIC_DRAW);
+
+    // Avec l'indirect, drawID vaut baseInstance (0, 1, 2...) ; sinon l'attribut reste désactivé
+    // et sa valeur constante est fixée par glVertexAttribI1ui avant chaque appel
+    if (multiDrawIndirect) {
+        std::vector<GLuint> drawIds(ranges.size());
+        for (size_t i = 0; i < drawIds.size(); ++i) drawIds[i] = static_cast<GLuint>(i);
+        glBindBuffer(GL_ARRAY_BUFFER, drawIdVBO);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(GLuint) * drawIds.size(), drawIds.data(), GL_STATIC_DRAW);
+        glVertexAttribIPointer(DRAW_ID_LOCATION, 1, GL_UNSIGNED_INT, 0, (void *)0);
+        glVertexAttribDivisor(DRAW_ID_LOCATION, 1);
+        glEnableVertexAttribArray(DRAW_ID_LOCATION);
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void BatchRenderer::writeObjectData(const GameObject& object) {
+    glm::mat4 model = object.getTransform().getMatrix();
+    const Material& material = object.getMaterial();
+    objectData.push_back(model[0]);
+    objectData.push_back(model[1]);
+    objectData.push_back(model[2]);
+    objectData.push_back(model[3]);
+    objectData.push_back(object.getColor());
+    objectData.push_back(glm::vec4(material.getAmbient(), static_cast<float>(material.getShininess())));
+    objectData.push_back(glm::vec4(material.getDiffuse(), 0.f));
+    objectData.push_back(glm::vec4(material.getSpecular(), 0.f));
+}
+
+void BatchRenderer::draw(const std::vector<std::unique_ptr<GameObject>>& objects, const Shader& shader) {
+    if (!rangesMatch(objects)) {
+        rebuildArena(objects);
+    }
+
+    // Objets affichés, regroupés par texture puis par mode de remplissage
+    std::vector<const MeshRange*> visible;
+    visible.reserve(ranges.size());
+    for (const MeshRange& range : ranges) {
+        if (range.object->isShowMesh() && range.object->isInFrustum()) visible.push_back(&range);
+    }
+    std::stable_sort(visible.begin(), visible.end(), [](const MeshRange* a, const MeshRange* b) {
+        if (a->object->getTextureID() != b->object->getTextureID()) return a->object->getTextureID() < b->object->getTextureID();
+        return a->object->getIsWireframe() < b->object->getIsWireframe();
+    });
+
+    commands.clear();
+    objectData.clear();
+    drawCallCount = 0;
+    for (const MeshRange* range : visible) {
+        GLuint drawId = static_cast<GLuint>(commands.size());
+        commands.push_back({range->indexCount, 1, range->firstIndex, range->baseVertex, drawId});
+        writeObjectData(*range->object);
+    }
+    if (commands.empty()) return;
+
+    glBindBuffer(GL_TEXTURE_BUFFER, objectBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, sizeof(glm::vec4) * objectData.size(), objectData.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    if (multiDrawIndirect) {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, sizeof(DrawCommand) * commands.size(), commands.data(), GL_STREAM_DRAW);
+    }
+
+    glBindVertexArray(VAO);
+    glActiveTexture(GL_TEXTURE0 + OBJECT_DATA_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, objectTexture);
+    glActiveTexture(GL_TEXTURE0);
+
+    GLint textureIDLoc = shader.getUniformLocation("textureID");
+    size_t begin = 0;
+    while (begin < visible.size()) {
+        GameObject *first = visible[begin]->object;
+        size_t end = begin + 1;
+        while (end < visible.size() && visible[end]->object->getTextureID() == first->getTextureID()
+               && visible[end]->object->getIsWireframe() == first->getIsWireframe()) {
+            ++end;
+        }
+
+        glPolygonMode(GL_FRONT_AND_BACK, first->getIsWireframe() ? GL_LINE : GL_FILL);
+        glUniform1i(textureIDLoc, first->getTextureID());
+        glBindTexture(GL_TEXTURE_2D, first->getTextureID());
+
+        if (multiDrawIndirect) {
+            glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_SHORT, (void *)(begin * sizeof(DrawCommand)),
+                                        static_cast<GLsizei>(end - begin), 0);
+            ++drawCallCount;
+        } else {
+            for (size_t i = begin; i < end; ++i) {
+                const DrawCommand& command = commands[i];
+                glVertexAttribI1ui(DRAW_ID_LOCATION, command.baseInstance);
+                glDrawElementsBaseVertex(GL_TRIANGLES, command.count, GL_UNSIGNED_SHORT,
+                                         (void *)(command.firstIndex * sizeof(unsigned short)), command.baseVertex);
+                ++drawCallCount;
+            }
+        }
+        begin = end;
+    }
+
+    glBindVertexArray(0);
+    if (multiDrawIndirect) glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
@@ -0,0 +1,70 @@
+#ifndef BATCH_RENDERER_HPP__
+#define BATCH_RENDERER_HPP__
+
+#include <vector>
+#include <memory>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "GameObject.hpp"
+#include "Shader.hpp"
+
+// Rendu groupé des meshes de la scène : sommets et indices de tous les objets dans deux
+// buffers partagés, données par objet (transformation, couleur, matériau) dans un texture
+// buffer lu par batch_vertex_shader.glsl. Un appel par couple (texture, wireframe) avec
+// glMultiDrawElementsIndirect, sinon un glDrawElementsBaseVertex par objet sous OpenGL 3.3.
+class BatchRenderer {
+public:
+    static const GLuint OBJECT_DATA_UNIT = 1;   // Unité de texture du sampler objectData
+    static const int TEXELS_PER_OBJECT = 8;     // model (4), couleur, ambiant + brillance, diffus, spéculaire
+    static const GLuint DRAW_ID_LOCATION = 3;   // Attribut entier : indice de l'objet dans objectData
+
+    // Disposition imposée par GL_DRAW_INDIRECT_BUFFER
+    struct DrawCommand {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        GLuint baseInstance;    // Sert d'indice d'objet via l'attribut drawID (diviseur 1)
+    };
+
+private:
+    // Emplacement d'un mesh dans les buffers partagés
+    struct MeshRange {
+        GameObject *object;
+        unsigned int meshVersion;
+        GLuint firstIndex;
+        GLuint indexCount;
+        GLint baseVertex;
+    };
+
+    static bool enabled;
+
+    GLuint VAO = 0, vertexVBO = 0, indexVBO = 0, drawIdVBO = 0;
+    GLuint indirectBuffer = 0, objectBuffer = 0, objectTexture = 0;
+    bool multiDrawIndirect = false;
+
+    std::vector<MeshRange> ranges;
+    std::vector<DrawCommand> commands;      // Une commande par objet affiché, triées par groupe
+    std::vector<glm::vec4> objectData;      // TEXELS_PER_OBJECT texels par commande
+    size_t drawCallCount = 0;
+
+    bool rangesMatch(const std::vector<std::unique_ptr<GameObject>>& objects) const;
+    void rebuildArena(const std::vector<std::unique_ptr<GameObject>>& objects);
+    void writeObjectData(const GameObject& object);
+
+public:
+    BatchRenderer() {}
+    BatchRenderer(const BatchRenderer&) = delete;
+    BatchRenderer& operator=(const BatchRenderer&) = delete;
+
+    void draw(const std::vector<std::unique_ptr<GameObject>>& objects, const Shader& shader);
+
+    static bool& isEnabled() { return enabled; }
+    bool usesMultiDrawIndirect() const { return multiDrawIndirect; }
+    size_t getDrawCallCount() const { return drawCallCount; }
+    size_t getObjectCount() const { return commands.size(); }
+
+    ~BatchRenderer();
+};
+
+#endif
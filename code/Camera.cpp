@@ -122,29 +122,23 @@ void Camera::scroll_callback(GLFWwindow* window, double xOffset, double yOffset)
     m_scrollOffset = yOffset; // Update scroll offset
 }
 
-void Camera::setupEditorLight(GLuint shaderID) {
-    // Obtenir la position et la direction de la caméra
-    glm::vec3 lightPos = m_position;
-    // std::cout << m_position.x << " " << m_position.y << " " << m_position.z << std::endl; 
+void Camera::updateFrameUniforms(FrameUniforms& frameUniforms, float aspectRatio) const
+{
+    FrameUniforms::Data data;
+    data.view = m_viewMatrix;
+    data.projection = getProjectionMatrix(aspectRatio);
+    data.viewPos = glm::vec4(m_position, 1.0f);
 
-    // Définir les paramètres d'éclairage
-    glm::vec3 lightColor = glm::vec3(1.0f, 1.0f, 1.0f); // Lumière blanche
+    // Lumière d'édition placée sur la caméra
+    data.lightPos = glm::vec4(m_position, 1.0f);
+    data.lightColor = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f); // Lumière blanche
 
-    // Envoyer les uniformes au shader
-    glUniform3fv(glGetUniformLocation(shaderID, "lightPos"), 1, &lightPos[0]);
-    glUniform3fv(glGetUniformLocation(shaderID, "lightColor"), 1, &lightColor[0]);
+    frameUniforms.update(data);
 }
 
-void Camera::sendToShader(GLuint programID, float aspectRatio) const
+Frustum Camera::getFrustum(float aspectRatio) const
 {
-    // View matrix
-    GLuint viewLoc = glGetUniformLocation(programID, "view");
-    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, &m_viewMatrix[0][0]);
-
-    // Projection matrix
-    glm::mat4 projectionMatrix = getProjectionMatrix(aspectRatio);
-    GLuint projLoc = glGetUniformLocation(programID, "projection");
-    glUniformMatrix4fv(projLoc, 1, GL_FALSE, &projectionMatrix[0][0]);
+    return Frustum(getProjectionMatrix(aspectRatio) * m_viewMatrix);
 }
 
 glm::mat4 Camera::getViewMatrix() const
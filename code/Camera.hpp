@@ -17,6 +17,9 @@
 #include <imgui/imgui_impl_glfw.h>
 #include <imgui/imgui_impl_opengl3.h>
 
+#include "FrameUniforms.hpp"
+#include "Frustum.hpp"
+
 
 enum class InputMode {
     Fixed, // Mode fixe
@@ -56,11 +59,13 @@ public:
 
     void update(float deltaTime, GLFWwindow* window);
     void scroll_callback(GLFWwindow* window, double xOffset, double yOffset);
-    void setupEditorLight(GLuint shaderID);
-    void sendToShader(GLuint programID, float aspectRatio) const;
+    // Vue, projection, position de la caméra et lumière d'édition (attachée à la caméra)
+    void updateFrameUniforms(FrameUniforms& frameUniforms, float aspectRatio) const;
 
     glm::mat4 getViewMatrix() const;
     glm::mat4 getProjectionMatrix(float aspectRatio) const;
+    // Pyramide de vue dans l'espace monde, pour le culling avant tout appel OpenGL
+    Frustum getFrustum(float aspectRatio) const;
 
     void saveState();
     bool getSavedState();
@@ -0,0 +1,18 @@
+#include "FrameUniforms.hpp"
+
+void FrameUniforms::update(const Data& data) {
+    if (UBO == 0) {
+        glGenBuffers(1, &UBO);
+        glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(Data), nullptr, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, BINDING, UBO);
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Data), &data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void FrameUniforms::bindProgram(GLuint programID) {
+    GLuint blockIndex = glGetUniformBlockIndex(programID, "FrameData");
+    if (blockIndex != GL_INVALID_INDEX) glUniformBlockBinding(programID, blockIndex, BINDING);
+}
@@ -0,0 +1,37 @@
+#ifndef FRAME_UNIFORMS_HPP__
+#define FRAME_UNIFORMS_HPP__
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+// Caméra et lumière de la frame, dans un uniform buffer partagé par tous les shaders
+// (bloc "FrameData" des fichiers .glsl), mis à jour une seule fois par frame.
+class FrameUniforms {
+public:
+    static const GLuint BINDING = 0; // Point de liaison du bloc FrameData
+
+    // Disposition std140 : mat4 et vec4 uniquement, sans bourrage
+    struct Data {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::vec4 viewPos;
+        glm::vec4 lightPos;
+        glm::vec4 lightColor;
+    };
+    static_assert(sizeof(Data) == 176, "FrameData doit suivre la disposition std140");
+
+private:
+    GLuint UBO = 0; // Conservé pendant toute la durée du contexte
+
+public:
+    FrameUniforms() {}
+    FrameUniforms(const FrameUniforms&) = delete;
+    FrameUniforms& operator=(const FrameUniforms&) = delete;
+
+    void update(const Data& data);
+
+    // Relie le bloc FrameData d'un programme au point BINDING (sans effet s'il ne l'utilise pas)
+    static void bindProgram(GLuint programID);
+};
+
+#endif
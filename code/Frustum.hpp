@@ -0,0 +1,53 @@
+#ifndef FRUSTUM_HPP__
+#define FRUSTUM_HPP__
+
+#include <array>
+#include <glm/glm.hpp>
+
+// Boîte englobante transformée par une matrice affine (méthode d'Arvo) : plus petite boîte
+// alignée sur les axes contenant les 8 coins transformés
+inline void transformAABB(const glm::mat4& m, const glm::vec3& minBounds, const glm::vec3& maxBounds,
+                          glm::vec3& outMin, glm::vec3& outMax) {
+    outMin = outMax = glm::vec3(m[3]);
+    for (int c = 0; c < 3; ++c) {
+        glm::vec3 a = glm::vec3(m[c]) * minBounds[c];
+        glm::vec3 b = glm::vec3(m[c]) * maxBounds[c];
+        outMin += glm::min(a, b);
+        outMax += glm::max(a, b);
+    }
+}
+
+// Pyramide de vue extraite d'une matrice de projection (Gribb et Hartmann).
+// Les plans sont exprimés dans l'espace d'entrée de la matrice : monde pour projection * view,
+// espace objet pour projection * view * model.
+struct Frustum {
+    std::array<glm::vec4, 6> planes; // ax + by + cz + d >= 0 à l'intérieur
+
+    Frustum() {}
+    explicit Frustum(const glm::mat4& m) {
+        glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+        glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+        glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+        glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+        planes[0] = row3 + row0; // Gauche
+        planes[1] = row3 - row0; // Droite
+        planes[2] = row3 + row1; // Bas
+        planes[3] = row3 - row1; // Haut
+        planes[4] = row3 + row2; // Proche
+        planes[5] = row3 - row2; // Lointain
+    }
+
+    // Faux uniquement si la boîte est entièrement derrière un des plans (test conservatif)
+    bool intersectsBox(const glm::vec3& minBounds, const glm::vec3& maxBounds) const {
+        for (const glm::vec4& plane : planes) {
+            // Coin le plus avancé dans la direction de la normale
+            glm::vec3 p(plane.x >= 0.f ? maxBounds.x : minBounds.x,
+                        plane.y >= 0.f ? maxBounds.y : minBounds.y,
+                        plane.z >= 0.f ? maxBounds.z : minBounds.z);
+            if (glm::dot(glm::vec3(plane), p) + plane.w < 0.f) return false;
+        }
+        return true;
+    }
+};
+
+#endif
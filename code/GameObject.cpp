@@ -85,34 +85,91 @@ void GameObject::rotate(float angle, const glm::vec3 &axis)
 /* ------------------------- BUFFERS -------------------------*/
 void GameObject::GenerateBuffers()
 {
+    GenerateBuffers(vertices.data(), vertices.size(), uvs.data(), uvs.size(),
+                    indices.data(), indices.size(), normals.data(), normals.size());
+}
+
+// Normale projetée sur l'octaèdre |x| + |y| + |z| = 1 puis dépliée sur le carré [-1, 1]²
+uint32_t GameObject::encodeNormal(const glm::vec3& normal) {
+    float l1 = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    if (l1 == 0.f) {
+        return glm::packSnorm2x16(glm::vec2(0.f));
+    }
+    glm::vec2 e = glm::vec2(normal.x, normal.y) / l1;
+    if (normal.z < 0.f) {
+        glm::vec2 s(e.x >= 0.f ? 1.f : -1.f, e.y >= 0.f ? 1.f : -1.f);
+        e = (glm::vec2(1.f) - glm::abs(glm::vec2(e.y, e.x))) * s;
+    }
+    return glm::packSnorm2x16(e);
+}
+
+// Les UV et normales manquantes (fichiers sans vt/vn) valent zéro, comme un VBO trop court lu par le GPU
+std::vector<PackedVertex> GameObject::packVertices(const glm::vec3 *vertexData, size_t vertexCount, const glm::vec2 *uvData, size_t uvCount,
+                                                   const glm::vec3 *normalData, size_t normalCount)
+{
+    std::vector<PackedVertex> packed(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        packed[i].position = vertexData[i];
+        packed[i].uv = glm::packHalf2x16(i < uvCount ? uvData[i] : glm::vec2(0.f));
+        packed[i].normal = encodeNormal(i < normalCount ? normalData[i] : glm::vec3(0.f));
+    }
+    return packed;
+}
+
+std::vector<PackedVertex> GameObject::getPackedVertices() const {
+    return packVertices(vertices.data(), vertices.size(), uvs.data(), uvs.size(), normals.data(), normals.size());
+}
+
+// Chargement depuis n'importe quels tableaux contigus (par défaut les vecteurs de l'objet)
+void GameObject::GenerateBuffers(const glm::vec3 *vertexData, size_t vertexCount, const glm::vec2 *uvData, size_t uvCount,
+                                 const unsigned short *indexData, size_t indexCount, const glm::vec3 *normalData, size_t normalCount)
+{
+    std::vector<PackedVertex> packed = packVertices(vertexData, vertexCount, uvData, uvCount, normalData, normalCount);
+    this->indexCount = static_cast<GLsizei>(indexCount);
+    ++meshVersion;
+
+    // Boîte englobante locale, transformée à la demande par updateWorldBounds
+    localMin = localMax = glm::vec3(0.f);
+    if (vertexCount > 0) {
+        localMin = localMax = vertexData[0];
+        for (size_t i = 1; i < vertexCount; ++i) {
+            localMin = glm::min(localMin, vertexData[i]);
+            localMax = glm::max(localMax, vertexData[i]);
+        }
+    }
+    boundsMatrix = glm::mat4(0.f);
+
     glGenVertexArrays(1, &vao);    // Le VAO qui englobe tout
-    glGenBuffers(1, &vboVertices); // VBO vertex
-    glGenBuffers(1, &vboUV);        // VBO uv
+    glGenBuffers(1, &vbo);         // VBO entrelacé : position, uv, normale
     glGenBuffers(1, &vboIndices);  // VBO d'élements indices pour draw triangles
-    glGenBuffers(1, &vboNormals);
-
-    // Binds + Chargement des buffers avec les donnéees de l'objets courant
-    // Vertices
-    glBindBuffer(GL_ARRAY_BUFFER, vboVertices);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec3) * vertices.size(), &vertices[0], GL_STATIC_DRAW);
-    // UV
-    glBindBuffer(GL_ARRAY_BUFFER, vboUV);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec2) * uvs.size(), &uvs[0], GL_STATIC_DRAW);
-    // Indices
+
+    // Le VAO mémorise les pointeurs d'attributs et le buffer d'indices : draw n'a plus qu'à le lier
+    glBindVertexArray(vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(PackedVertex) * packed.size(), packed.data(), GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(PackedVertex), (void *)offsetof(PackedVertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex), (void *)offsetof(PackedVertex, uv));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 2, GL_SHORT, GL_TRUE, sizeof(PackedVertex), (void *)offsetof(PackedVertex, normal));
+    glEnableVertexAttribArray(2);
+
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vboIndices);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned short) * indices.size(), &indices[0], GL_STATIC_DRAW);
-    // Normales
-    glBindBuffer(GL_ARRAY_BUFFER, vboNormals);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec3) * normals.size(), &normals[0], GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned short) * indexCount, indexData, GL_STATIC_DRAW);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 void GameObject::DeleteBuffers()
 {
-    glDeleteBuffers(1, &vboVertices);
+    glDeleteBuffers(1, &vbo);
     glDeleteBuffers(1, &vboIndices);
-    glDeleteBuffers(1, &vboUV);
-    glDeleteBuffers(1, &vboNormals);
     glDeleteVertexArrays(1, &vao);
+    vao = vbo = vboIndices = 0;
+    indexCount = 0;
 };
 
 void GameObject::draw(Shader &shader)
@@ -124,47 +181,46 @@ void GameObject::draw(Shader &shader)
         glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
     }
      // Matériaux (Phong Lighting)
-    glUniform3fv(glGetUniformLocation(shader.ID, "material.ambient"), 1, glm::value_ptr(material.getAmbient()));
-    glUniform3fv(glGetUniformLocation(shader.ID, "material.diffuse"), 1, glm::value_ptr(material.getDiffuse()));
-    glUniform3fv(glGetUniformLocation(shader.ID, "material.specular"), 1, glm::value_ptr(material.getSpecular()));
-    glUniform1f(glGetUniformLocation(shader.ID, "material.shininess"), material.getShininess());
+    glUniform3fv(shader.getUniformLocation("material.ambient"), 1, glm::value_ptr(material.getAmbient()));
+    glUniform3fv(shader.getUniformLocation("material.diffuse"), 1, glm::value_ptr(material.getDiffuse()));
+    glUniform3fv(shader.getUniformLocation("material.specular"), 1, glm::value_ptr(material.getSpecular()));
+    glUniform1f(shader.getUniformLocation("material.shininess"), material.getShininess());
 
     // --- Dessiner l'objet principal ---
     glBindVertexArray(vao); // Bind le VAO
-    glUniformMatrix4fv(glGetUniformLocation(shader.ID, "model"), 1, GL_FALSE, &transform.getMatrix()[0][0]); // Matrice de transformation
-    glUniform4fv(glGetUniformLocation(shader.ID, "color"), 1, &color[0]); // Couleur
+    glUniformMatrix4fv(shader.getUniformLocation("model"), 1, GL_FALSE, &transform.getMatrix()[0][0]); // Matrice de transformation
+    glUniform4fv(shader.getUniformLocation("color"), 1, &color[0]); // Couleur
 
-    // Bind et activer la texture
-    glUniform1i(glGetUniformLocation(shader.ID, "textureID"), textureID);
+    // Bind et activer la texture (sampler gameObjectTexture fixé à l'unité 0 une fois pour toutes)
+    glUniform1i(shader.getUniformLocation("textureID"), textureID);
 
     glActiveTexture(GL_TEXTURE0);
-    glUniform1i(glGetUniformLocation(shader.ID, "gameObjectTexture"), 0);
     glBindTexture(GL_TEXTURE_2D, textureID);
 
-    // Attributs Vertex: Positions, UVs et Normales
-    glBindBuffer(GL_ARRAY_BUFFER, vboVertices);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void *)0);
-    glEnableVertexAttribArray(0);
+    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, 0);
+    glBindVertexArray(0);
+}
 
-    // glPointSize(10.0f);
-    // glDrawArrays(GL_POINTS, 0, vertices.size());
+/* ------------------------- CULLING -------------------------*/
 
-    glBindBuffer(GL_ARRAY_BUFFER, vboUV);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, (void *)0);
-    glEnableVertexAttribArray(1);
+void GameObject::updateWorldBounds() {
+    glm::mat4 model = transform.getMatrix();
+    if (model == boundsMatrix) return;
+    boundsMatrix = model;
+    transformAABB(model, localMin, localMax, worldMin, worldMax);
+}
 
-    glBindBuffer(GL_ARRAY_BUFFER, vboNormals);
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 0, (void *)0);
-    glEnableVertexAttribArray(2);
+void GameObject::cull(const Frustum& frustum) {
+    updateWorldBounds();
+    inFrustum = frustum.intersectsBox(worldMin, worldMax);
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vboIndices);
-    glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_SHORT, 0);
-
-    // Désactiver les layouts et delink VAO
-    glBindVertexArray(0);
-    glDisableVertexAttribArray(0);
-    glDisableVertexAttribArray(1);
-    glDisableVertexAttribArray(2);
+    // La grille couvre sa propre boîte (légèrement plus grande que celle du mesh)
+    voxelInFrustum = true;
+    if (gridInitialized) {
+        glm::vec3 gridMin, gridMax;
+        transformAABB(boundsMatrix, grid->getMinBounds(), grid->getMaxBounds(), gridMin, gridMax);
+        voxelInFrustum = frustum.intersectsBox(gridMin, gridMax);
+    }
 }
 
 /* ------------------------- UPDATE -------------------------*/
@@ -179,9 +235,26 @@ void GameObject::initTexture() {
     if (textureID != 0) { // S'il y a une texture sur le GameObject
         std::cout << textureID << ": " << texturePath << std::endl;
         glActiveTexture(GL_TEXTURE0);
-        loadTexture2DFromFilePath(texturePath); 
-        glUniform1i(glGetUniformLocation(shader.ID, "gameObjectTexture"), 0);
+        // Même texture partagée si le fichier est déjà chargé
+        setCachedTexture(TextureCache::instance().acquire(texturePath));
+        shader.setInt("gameObjectTexture", 0);
+    }
+}
+
+// La nouvelle texture est acquise avant l'appel : une texture identique reste chargée
+void GameObject::setCachedTexture(GLuint texture) {
+    releaseTexture();
+    textureID = texture;
+    ownsCachedTexture = texture != 0;
+}
+
+// Seuls les identifiants obtenus du cache lui sont rendus
+void GameObject::releaseTexture() {
+    if (ownsCachedTexture) {
+        TextureCache::instance().release(textureID);
+        ownsCachedTexture = false;
     }
+    textureID = 0;
 }
 
 /* ------------------------- INTERFACE -------------------------*/
@@ -226,6 +299,12 @@ void GameObject::updateInterfaceTransform(float _deltaTime) {
     }
 }
 
+void GameObject::updateLOD(const glm::mat4& view, const glm::mat4& projection, float viewportHeight) {
+    if (gridInitialized && showVoxel) {
+        grid->updateLOD(transform.getMatrix(), view, projection, viewportHeight);
+    }
+}
+
 void GameObject::drawVoxel(Shader &shader) {
     if (isWireframeVoxel) {
         glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
@@ -234,6 +313,11 @@ void GameObject::drawVoxel(Shader &shader) {
     }
 
     if(gridInitialized) {
-        grid->draw(shader.ID, transform.getMatrix());
+        grid->draw(shader, transform.getMatrix());
     }
 }
+
+/* ------------------------- DESTRUCTOR -------------------------*/
+GameObject::~GameObject() {
+    releaseTexture();
+}
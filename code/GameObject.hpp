@@ -18,13 +18,28 @@
 #include <string>
 #include <cstring>
 #include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <vector>
 
 #include "Transform.hpp"
 #include "Material.h"
 #include "Shader.hpp"
 #include "texture.hpp"
+#include "TextureCache.hpp"
 #include "RegularGrid.hpp"
 #include "AdaptativeGrid.hpp"
+#include "Frustum.hpp"
+
+// Sommet entrelacé (20 octets au lieu de 32 répartis sur trois VBO) :
+// UV en demi-flottants, normale encodée en octaèdre sur deux snorm16
+struct PackedVertex {
+    glm::vec3 position;
+    uint32_t uv;        // packHalf2x16
+    uint32_t normal;    // packSnorm2x16 de l'encodage octaédrique
+};
+static_assert(sizeof(PackedVertex) == 20, "PackedVertex doit rester compact");
 
 enum class GridType {
     Regular,
@@ -41,11 +56,18 @@ protected:
     Shader shader; 
 
     // BUFFERS
-    GLuint vao;
-    GLuint vboVertices;
-    GLuint vboIndices;
-    GLuint vboUV;
-    GLuint vboNormals; 
+    GLuint vao = 0;         // Attributs configurés une seule fois à la création
+    GLuint vbo = 0;         // Sommets entrelacés (PackedVertex)
+    GLuint vboIndices = 0;
+    GLsizei indexCount = 0;
+    unsigned int meshVersion = 0; // Incrémenté à chaque envoi des sommets (BatchRenderer)
+
+    // CULLING
+    glm::vec3 localMin {0.f}, localMax {0.f};   // Boîte du mesh, calculée au chargement
+    glm::vec3 worldMin {0.f}, worldMax {0.f};   // Boîte transformée, recalculée si la transformation change
+    glm::mat4 boundsMatrix {0.f};               // Transformation ayant servi à worldMin/worldMax
+    bool inFrustum = true;
+    bool voxelInFrustum = true;
 
     // UNIFORM LOCATION
     GLuint typeULoc;
@@ -64,6 +86,7 @@ protected:
     // TEXTURE
     int textureID; // 0 = flatColor sinon Texture
     const char *texturePath;
+    bool ownsCachedTexture = false; // textureID acquis auprès du TextureCache, à libérer
 
     // // MATERIAL 
     Material material; 
@@ -117,10 +140,27 @@ public:
     std::vector<glm::vec3> getVertices() const;
     int setId(int _id);
     void setMaterial(const Material& _material);
+    const Material& getMaterial() const { return material; }
+    const Transform& getInitialTransform() const { return initialTransform; }
+    int getTextureID() const { return textureID; }
+    void setTextureID(int newTextureID) { releaseTexture(); textureID = newTextureID; }
     void setAmbient(glm::vec3 _ambient);
+    const std::vector<unsigned short>& getIndexData() const { return indices; }
+    std::vector<PackedVertex> getPackedVertices() const;
+    GLsizei getIndexCount() const { return indexCount; }
+    unsigned int getMeshVersion() const { return meshVersion; }
+
+    /* ------------------------- CULLING -------------------------*/
+    void updateWorldBounds();
+    const glm::vec3& getWorldMin() const { return worldMin; }
+    const glm::vec3& getWorldMax() const { return worldMax; }
+    // Met à jour inFrustum et voxelInFrustum, sans appel OpenGL
+    void cull(const Frustum& frustum);
+    bool isInFrustum() const { return inFrustum; }
+    bool isVoxelInFrustum() const { return voxelInFrustum; }
 
     /* ----------------------------- UPDATE -----------------------------*/
-    void update(float deltaTime);
+    virtual void update(float deltaTime);
 
     /* ------------------------- TRANSFORMATIONS -------------------------*/
     void translate(const glm::vec3 &translation);
@@ -129,13 +169,21 @@ public:
 
     /* ------------------------- BUFFERS -------------------------*/
     void GenerateBuffers();
+    void GenerateBuffers(const glm::vec3 *vertexData, size_t vertexCount, const glm::vec2 *uvData, size_t uvCount,
+                         const unsigned short *indexData, size_t indexCount, const glm::vec3 *normalData, size_t normalCount);
     void DeleteBuffers();
+    static uint32_t encodeNormal(const glm::vec3& normal); // Encodage octaédrique
+    static std::vector<PackedVertex> packVertices(const glm::vec3 *vertexData, size_t vertexCount, const glm::vec2 *uvData, size_t uvCount,
+                                                  const glm::vec3 *normalData, size_t normalCount);
 
     void draw(Shader &shader);
     void drawVoxel(Shader &shader);
+    void updateLOD(const glm::mat4& view, const glm::mat4& projection, float viewportHeight);
 
     /* ------------------------- TEXTURES -------------------------*/
     void initTexture();
+    void setCachedTexture(GLuint texture); // Remplace la texture par une référence acquise auprès du TextureCache
+    void releaseTexture();
 
     /* ------------------------- INTERFACE -------------------------*/
     void resetParameters();
@@ -164,7 +212,7 @@ public:
 
 
     /* ------------------------- DESTRUCTOR -------------------------*/
-    virtual ~GameObject() = default;
+    virtual ~GameObject();
 };
 
 #endif
\ No newline at end of file
@@ -1,25 +1,137 @@
 #include "Grid.hpp"
 #include <iostream>
+#include <cstring>
+
+namespace {
+    // Envoi des éléments modifiés du buffer lié à GL_ARRAY_BUFFER, regroupés en plages contiguës
+    void uploadRanges(std::vector<size_t>& dirty, size_t count, size_t stride, const void* data) {
+        std::sort(dirty.begin(), dirty.end());
+        dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+        const char* bytes = static_cast<const char*>(data);
+        size_t begin = 0;
+        while (begin < dirty.size() && dirty[begin] < count) {
+            size_t end = begin + 1;
+            while (end < dirty.size() && dirty[end] == dirty[end - 1] + 1 && dirty[end] < count) ++end;
+            glBufferSubData(GL_ARRAY_BUFFER, dirty[begin] * stride, (end - begin) * stride, bytes + dirty[begin] * stride);
+            begin = end;
+        }
+    }
 
-void Grid::initializeBuffers() {
-    // if (VAO != 0) return; // Éviter une double initialisation
+    // Tampon d'écriture : le fichier reçoit des blocs de 1 Mo plutôt qu'un appel par valeur
+    class BlockWriter {
+    private:
+        std::ofstream& out;
+        std::vector<char> buffer;
+        size_t used = 0;
+
+    public:
+        explicit BlockWriter(std::ofstream& out, size_t blockSize = 1 << 20) : out(out), buffer(blockSize) {}
+        ~BlockWriter() { flush(); }
+
+        template <typename T>
+        void write(const T& value) {
+            if (used + sizeof(T) > buffer.size()) flush();
+            std::memcpy(buffer.data() + used, &value, sizeof(T));
+            used += sizeof(T);
+        }
 
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);using Voxel = std::tuple<int, int, int>;
+        void flush() {
+            out.write(buffer.data(), used);
+            used = 0;
+        }
+    };
+}
 
-    glBindVertexArray(VAO);
+bool Grid::instancedRendering = true;
+bool Grid::packedRendering = true;
+GLuint Grid::cubeVBO = 0;
 
-    // Préparer les données des voxels
-    std::vector<VoxelData> bufferData;
-    for (const auto& voxel : voxels) {
-        bufferData.emplace_back(voxel.center, voxel.halfSize, voxel.isEmpty, voxel.isSelected);
-        // std::cout << voxel.isEmpty << std::endl;
-        // std::cout << "center={" << bufferData.back().center.x << ", " << bufferData.back().center.y << ", " << bufferData.back().center.z << "} halfSize=" << bufferData.back().halfSize << std::endl;
+Grid::~Grid() {
+    if (VAO != 0) {
+        glDeleteVertexArrays(1, &VAO);
+        glDeleteBuffers(1, &VBO);
+    }
+    if (instanceVAO != 0) {
+        glDeleteVertexArrays(1, &instanceVAO);
+        glDeleteBuffers(1, &instanceVBO);
     }
-    // std::cout << bufferData.size() << std::endl;
+}
+
+void Grid::initializeBuffers() {
+    // Buffers créés une seule fois par grille : les appels suivants ne font que renvoyer les données
+    if (VAO == 0) {
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &VBO);
+        glBindVertexArray(VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        setupVoxelAttributes();
+        glBindVertexArray(0);
+    }
+
+    // Les rendus instanciés n'ont pas besoin des VoxelData complets (72 octets par voxel) :
+    // envoi différé jusqu'au premier dessin par le geometry shader
+    voxelBufferValid = false;
+    dirtyVoxels.clear();
+    instancesDirty = true;
+    chunks.reset(canPackVoxels() ? getGridSize() : glm::ivec3(0));
+    if (!instancedRendering) uploadVoxelBuffer();
+}
+
+void Grid::uploadVoxelBuffer() {
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, bufferData.size() * sizeof(VoxelData), bufferData.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, voxels.size() * sizeof(VoxelData), voxels.data(), GL_DYNAMIC_DRAW);
+    voxelBufferSize = voxels.size();
+    voxelBufferValid = true;
+}
+
+void Grid::uploadDirtyVoxels() {
+    if (dirtyVoxels.empty()) return;
+
+    // Chemin geometry shader : plages de VoxelData
+    if (VAO != 0 && voxelBufferValid && voxelBufferSize == voxels.size()) {
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        uploadRanges(dirtyVoxels, voxels.size(), sizeof(VoxelData), voxels.data());
+    }
+
+    // Rendu instancié : ajout en fin de liste, retrait en déplaçant le dernier emplacement
+    if (instanceVAO != 0 && !instancesDirty) {
+        std::vector<size_t> dirtySlots;
+        for (size_t index : dirtyVoxels) {
+            const VoxelData& voxel = voxels[index];
+            int slot = instanceSlots[index];
+            if (isInstanceVisible(voxel)) {
+                if (slot < 0) {
+                    slot = static_cast<int>(instanceData.size());
+                    instanceData.emplace_back();
+                    instanceVoxels.push_back(index);
+                    instanceSlots[index] = slot;
+                }
+                instanceData[slot] = makeInstance(voxel);
+                dirtySlots.push_back(slot);
+            } else if (slot >= 0) {
+                size_t last = instanceData.size() - 1;
+                instanceData[slot] = instanceData[last];
+                instanceVoxels[slot] = instanceVoxels[last];
+                instanceSlots[instanceVoxels[slot]] = slot;
+                instanceData.pop_back();
+                instanceVoxels.pop_back();
+                instanceSlots[index] = -1;
+                dirtySlots.push_back(slot);
+            }
+        }
 
+        if (instanceData.size() > instanceCapacity) {
+            uploadInstances(instanceData);
+        } else {
+            glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+            uploadRanges(dirtySlots, instanceData.size(), sizeof(VoxelInstance), instanceData.data());
+            instanceCount = instanceData.size();
+        }
+    }
+    dirtyVoxels.clear();
+}
+
+void Grid::setupVoxelAttributes() {
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(VoxelData), (void*)offsetof(VoxelData, center));
 
@@ -32,8 +144,8 @@ void Grid::initializeBuffers() {
     glEnableVertexAttribArray(3);
     glVertexAttribPointer(3, 1, GL_INT, GL_FALSE, sizeof(VoxelData), (void*)offsetof(VoxelData, isSelected));
 
-    // glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    glEnableVertexAttribArray(4);
+    glVertexAttribIPointer(4, 1, GL_INT, sizeof(VoxelData), (void*)offsetof(VoxelData, faceMask));
 }
 
 bool Grid::triangleIntersectsAABB(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2,
@@ -91,10 +203,132 @@ bool Grid::testAxis(const glm::vec3& axis, const glm::vec3& t0, const glm::vec3&
     return !(triMin > boxRadius || triMax < -boxRadius);
 }
 
-void Grid::draw(GLuint shaderID, glm::mat4 transformMat) {
-    // std::cout << shaderID << std::endl;
-    glUniformMatrix4fv(glGetUniformLocation(shaderID, "model"), 1, GL_FALSE, &transformMat[0][0]); // Matrice de transformation
-    glUniform3fv(glGetUniformLocation(shaderID, "objectColor"), 1, &color[0]); // Couleur
+bool Grid::isInstanceVisible(const VoxelData& voxel) {
+    // Voxel plein entièrement entouré de voxels pleins : rien à dessiner
+    return (voxel.isEmpty == 0 && voxel.faceMask != 0) || voxel.isSelected != 0;
+}
+
+VoxelInstance Grid::makeInstance(const VoxelData& voxel) {
+    return {glm::vec4(voxel.center, voxel.halfSize), voxel.isSelected, voxel.isSelected ? VOXEL_ALL_FACES : voxel.faceMask};
+}
+
+void Grid::rebuildInstances() {
+    instanceData.clear();
+    instanceVoxels.clear();
+    instanceSlots.assign(voxels.size(), -1);
+    for (size_t i = 0; i < voxels.size(); ++i) {
+        const VoxelData& voxel = voxels[i];
+        if (isInstanceVisible(voxel)) {
+            instanceSlots[i] = static_cast<int>(instanceData.size());
+            instanceData.push_back(makeInstance(voxel));
+            instanceVoxels.push_back(i);
+        }
+    }
+}
+
+void Grid::uploadInstances(const std::vector<VoxelInstance>& instances) {
+    if (cubeVBO == 0) {
+        // 6 faces * 2 triangles, sommets dans [-1, 1] mis à l'échelle par la demi-taille dans le shader.
+        // Faces dans l'ordre des bits de faceMask : la face d'un sommet est gl_VertexID / 6
+        const float cube[] = {
+            // Position            Normale
+            -1, -1, -1,  -1,  0,  0,   -1, -1,  1,  -1,  0,  0,   -1,  1,  1,  -1,  0,  0,
+            -1, -1, -1,  -1,  0,  0,   -1,  1,  1,  -1,  0,  0,   -1,  1, -1,  -1,  0,  0,
+             1, -1, -1,   1,  0,  0,    1,  1,  1,   1,  0,  0,    1, -1,  1,   1,  0,  0,
+             1, -1, -1,   1,  0,  0,    1,  1, -1,   1,  0,  0,    1,  1,  1,   1,  0,  0,
+            -1, -1, -1,   0, -1,  0,    1, -1, -1,   0, -1,  0,    1, -1,  1,   0, -1,  0,
+            -1, -1, -1,   0, -1,  0,    1, -1,  1,   0, -1,  0,   -1, -1,  1,   0, -1,  0,
+            -1,  1, -1,   0,  1,  0,   -1,  1,  1,   0,  1,  0,    1,  1,  1,   0,  1,  0,
+            -1,  1, -1,   0,  1,  0,    1,  1,  1,   0,  1,  0,    1,  1, -1,   0,  1,  0,
+            -1, -1, -1,   0,  0, -1,    1,  1, -1,   0,  0, -1,    1, -1, -1,   0,  0, -1,
+            -1, -1, -1,   0,  0, -1,   -1,  1, -1,   0,  0, -1,    1,  1, -1,   0,  0, -1,
+            -1, -1,  1,   0,  0,  1,    1, -1,  1,   0,  0,  1,    1,  1,  1,   0,  0,  1,
+            -1, -1,  1,   0,  0,  1,    1,  1,  1,   0,  0,  1,   -1,  1,  1,   0,  0,  1
+        };
+        glGenBuffers(1, &cubeVBO);
+        glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(cube), cube, GL_STATIC_DRAW);
+    }
+
+    if (instanceVAO == 0) {
+        glGenVertexArrays(1, &instanceVAO);
+        glGenBuffers(1, &instanceVBO);
+        glBindVertexArray(instanceVAO);
+
+        glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+
+        glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(VoxelInstance), (void*)offsetof(VoxelInstance, centerHalfSize));
+        glVertexAttribDivisor(2, 1);
+        glEnableVertexAttribArray(3);
+        glVertexAttribIPointer(3, 1, GL_INT, sizeof(VoxelInstance), (void*)offsetof(VoxelInstance, isSelected));
+        glVertexAttribDivisor(3, 1);
+        glEnableVertexAttribArray(4);
+        glVertexAttribIPointer(4, 1, GL_INT, sizeof(VoxelInstance), (void*)offsetof(VoxelInstance, faceMask));
+        glVertexAttribDivisor(4, 1);
+        glBindVertexArray(0);
+    }
+
+    // Réallocation seulement si la liste dépasse la capacité du buffer
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    if (instances.size() > instanceCapacity) {
+        instanceCapacity = std::max<size_t>(instances.size() + instances.size() / 2, 1024);
+        glBufferData(GL_ARRAY_BUFFER, instanceCapacity * sizeof(VoxelInstance), nullptr, GL_DYNAMIC_DRAW);
+    }
+    if (!instances.empty()) {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, instances.size() * sizeof(VoxelInstance), instances.data());
+    }
+    instanceCount = instances.size();
+}
+
+void Grid::drawPackedVoxels(const Shader& shader, const glm::mat4& transformMat) {
+    float voxelSize = getPackedVoxelSize();
+    glUniformMatrix4fv(shader.getUniformLocation("model"), 1, GL_FALSE, &transformMat[0][0]); // Matrice de transformation
+    glUniform3fv(shader.getUniformLocation("objectColor"), 1, &color[0]); // Couleur
+    glUniform1f(shader.getUniformLocation("voxelSize"), voxelSize);
+    chunks.draw(shader, minBounds, voxelSize);
+}
+
+void Grid::updateLOD(const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection, float /*viewportHeight*/) {
+    if (usesPackedRendering()) {
+        chunks.cull(Frustum(projection * view * model), minBounds, getPackedVoxelSize()); // Plans dans l'espace de la grille
+    }
+}
+
+void Grid::drawInstances(const Shader& shader, const glm::mat4& transformMat) {
+    glUniformMatrix4fv(shader.getUniformLocation("model"), 1, GL_FALSE, &transformMat[0][0]); // Matrice de transformation
+    glUniform3fv(shader.getUniformLocation("objectColor"), 1, &color[0]); // Couleur
+    if (instanceCount == 0) return;
+    glBindVertexArray(instanceVAO);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 36, static_cast<GLsizei>(instanceCount));
+    glBindVertexArray(0);
+}
+
+void Grid::draw(const Shader& shader, glm::mat4 transformMat) {
+    uploadDirtyVoxels();
+    if (instancedRendering) {
+        // Blocs envoyés par updateChunks en début de frame
+        if (usesPackedRendering()) {
+            drawPackedVoxels(shader, transformMat);
+            return;
+        }
+        if (instancesDirty) {
+            rebuildInstances();
+            uploadInstances(instanceData);
+            instancesDirty = false;
+        }
+        drawInstances(shader, transformMat);
+        return;
+    }
+
+    if (!voxelBufferValid || voxelBufferSize != voxels.size()) uploadVoxelBuffer();
+    glUniformMatrix4fv(shader.getUniformLocation("model"), 1, GL_FALSE, &transformMat[0][0]); // Matrice de transformation
+    glUniform3fv(shader.getUniformLocation("objectColor"), 1, &color[0]); // Couleur
     glBindVertexArray(VAO);
     glDrawArrays(GL_POINTS, 0, voxels.size());
     glBindVertexArray(0);
@@ -114,7 +348,24 @@ void Grid::removeDuplicates(std::vector<glm::vec3>& activeCorner) {
 }
 
 
-void Grid::createOffFile(std::vector<unsigned short> &indices, std::vector<glm::vec3> &vertices, std::string& filename){
+void Grid::weldTriangles(const std::vector<glm::vec3>& triangles, float epsilon,
+                         std::vector<unsigned int>& indices, std::vector<glm::vec3>& vertices) {
+    VertexWelder welder(epsilon, triangles.size() / 4);
+    std::vector<unsigned int> welded;
+    welded.reserve(triangles.size());
+    for (const glm::vec3& vertex : triangles) {
+        welded.push_back(welder.weld(vertex));
+    }
+
+    unsigned int offset = static_cast<unsigned int>(vertices.size());
+    indices.reserve(indices.size() + welded.size());
+    for (unsigned int index : welded) {
+        indices.push_back(offset + index);
+    }
+    vertices.insert(vertices.end(), welder.getPositions().begin(), welder.getPositions().end());
+}
+
+void Grid::createOffFile(std::vector<unsigned int> &indices, std::vector<glm::vec3> &vertices, std::string& filename){
     std::ofstream outFile(filename);
     if (!outFile) {
         std::cerr << "Erreur : impossible d'ouvrir le fichier pour écrire les données OFF." << std::endl;
@@ -141,5 +392,82 @@ void Grid::createOffFile(std::vector<unsigned short> &indices, std::vector<glm::
     std::cout << "Fichier OFF généré avec succès : output.off" << std::endl;
 }
 
+bool Grid::createPlyFile(const std::vector<unsigned int> &indices, const std::vector<glm::vec3> &vertices, const std::string& filename){
+    std::ofstream outFile(filename, std::ios::binary);
+    if (!outFile) {
+        std::cerr << "Erreur : impossible d'ouvrir le fichier pour écrire les données PLY." << std::endl;
+        return false;
+    }
+
+    // En-tête texte, données binaires
+    outFile << "ply\n"
+            << "format binary_little_endian 1.0\n"
+            << "element vertex " << vertices.size() << "\n"
+            << "property float x\n"
+            << "property float y\n"
+            << "property float z\n"
+            << "element face " << (indices.size() / 3) << "\n"
+            << "property list uchar uint vertex_indices\n"
+            << "end_header\n";
+
+    {
+        BlockWriter writer(outFile);
+        for (const auto &vertex : vertices) {
+            writer.write(vertex);
+        }
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            writer.write(static_cast<uint8_t>(3));
+            writer.write(static_cast<uint32_t>(indices[i]));
+            writer.write(static_cast<uint32_t>(indices[i + 1]));
+            writer.write(static_cast<uint32_t>(indices[i + 2]));
+        }
+    }
+
+    if (!outFile) {
+        std::cerr << "Erreur lors de l'écriture du fichier PLY " << filename << std::endl;
+        return false;
+    }
+    std::cout << "Fichier PLY généré avec succès : " << filename << std::endl;
+    return true;
+}
+
+bool Grid::createStlFile(const std::vector<unsigned int> &indices, const std::vector<glm::vec3> &vertices, const std::string& filename){
+    std::ofstream outFile(filename, std::ios::binary);
+    if (!outFile) {
+        std::cerr << "Erreur : impossible d'ouvrir le fichier pour écrire les données STL." << std::endl;
+        return false;
+    }
+
+    // En-tête de 80 octets (ne doit pas commencer par "solid") puis nombre de triangles
+    char header[80] = {};
+    std::strncpy(header, "Marching cubes export", sizeof(header) - 1);
+    outFile.write(header, sizeof(header));
+    uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+    outFile.write(reinterpret_cast<const char*>(&triangleCount), sizeof(triangleCount));
+
+    {
+        BlockWriter writer(outFile);
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            const glm::vec3 &v0 = vertices[indices[i]];
+            const glm::vec3 &v1 = vertices[indices[i + 1]];
+            const glm::vec3 &v2 = vertices[indices[i + 2]];
+            glm::vec3 normal = glm::cross(v1 - v0, v2 - v0);
+            float length = glm::length(normal);
+            writer.write(length > 0.0f ? normal / length : glm::vec3(0.0f));
+            writer.write(v0);
+            writer.write(v1);
+            writer.write(v2);
+            writer.write(static_cast<uint16_t>(0)); // Attributs
+        }
+    }
+
+    if (!outFile) {
+        std::cerr << "Erreur lors de l'écriture du fichier STL " << filename << std::endl;
+        return false;
+    }
+    std::cout << "Fichier STL généré avec succès : " << filename << std::endl;
+    return true;
+}
+
 
 
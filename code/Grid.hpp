@@ -15,7 +15,11 @@
 #include <functional>
 #include <unordered_set>
 #include <set>
+#include <cstdint>
 #include "MarchingCubesTable.hpp"
+#include "Shader.hpp"
+#include "VoxelChunks.hpp"
+#include <common/vboindexer.hpp>
 
 const float LITTLE_EPSILON = 1e-6f;
 const float EPSILON = 1e-4f;
@@ -27,6 +31,18 @@ enum class VoxelizationMethod {
     Surface    // Voxelisation de la surface uniquement
 };
 
+// Masque des faces visibles d'un voxel, même ordre que Morton::faceNeighbourCode :
+// bit 0 = -X, 1 = +X, 2 = -Y, 3 = +Y, 4 = -Z, 5 = +Z
+const int VOXEL_ALL_FACES = 0x3F;
+
+// Voxel compacté du rendu par vertex pulling (voxel_packed_vertex_shader.glsl) :
+// bits 0-7 x, 8-15 y, 16-23 z (coordonnées dans le bloc VoxelChunks), 24-29 faceMask, 30 sélectionné
+
+inline uint32_t packVoxelRecord(int x, int y, int z, int faceMask, bool selected) {
+    return static_cast<uint32_t>(x) | (static_cast<uint32_t>(y) << 8) | (static_cast<uint32_t>(z) << 16)
+         | (static_cast<uint32_t>(faceMask & VOXEL_ALL_FACES) << 24) | (selected ? 1u << 30 : 0u);
+}
+
 struct VoxelData {
     glm::vec3 center;   // Centre du voxel
     float halfSize;     // Moitié de la taille du voxel
@@ -34,6 +50,7 @@ struct VoxelData {
     int isSelected;
     glm::vec3 isEmptyOnAxe;
     std::array<int, 8> edge = {0, 0, 0, 0, 0, 0, 0, 0};
+    int faceMask = VOXEL_ALL_FACES; // Faces non collées à un voisin plein
 
     VoxelData() {}
 
@@ -41,6 +58,49 @@ struct VoxelData {
         : center(c), halfSize(hs), isEmpty(ie), isSelected(is) {}
 };
 
+// Instance du rendu instancié : un voxel plein (ou sélectionné), sans les données de voxelisation
+struct VoxelInstance {
+    glm::vec4 centerHalfSize;   // xyz : centre, w : demi-taille
+    int isSelected;
+    int faceMask;               // Faces à dessiner (toutes pour le voxel sélectionné)
+};
+
+// Grille d'occupation compactée (un bit par voxel), indexée x * Y * Z + y * Z + z
+// comme RegularGrid::voxels
+struct OccupancyGrid {
+    glm::ivec3 size {0, 0, 0};
+    glm::vec3 minBounds {0.f, 0.f, 0.f};
+    float voxelSize = 0.f;
+    std::vector<uint64_t> bits;
+
+    OccupancyGrid() {}
+    OccupancyGrid(const glm::ivec3& size, const glm::vec3& minBounds, float voxelSize)
+        : size(size), minBounds(minBounds), voxelSize(voxelSize),
+          bits((static_cast<size_t>(size.x) * size.y * size.z + 63) / 64, 0) {}
+
+    // Construction depuis une grille dense (un octet par voxel, 0 = vide)
+    static OccupancyGrid fromDense(const std::vector<uint8_t>& dense, const glm::ivec3& size,
+                                   const glm::vec3& minBounds, float voxelSize) {
+        OccupancyGrid grid(size, minBounds, voxelSize);
+        for (size_t i = 0; i < dense.size() && i < grid.voxelCount(); ++i) {
+            if (dense[i]) grid.bits[i >> 6] |= 1ull << (i & 63);
+        }
+        return grid;
+    }
+
+    size_t voxelCount() const { return static_cast<size_t>(size.x) * size.y * size.z; }
+    size_t index(int x, int y, int z) const { return (static_cast<size_t>(x) * size.y + y) * size.z + z; }
+    bool get(int x, int y, int z) const {
+        size_t i = index(x, y, z);
+        return (bits[i >> 6] >> (i & 63)) & 1;
+    }
+    void set(int x, int y, int z, bool filled) {
+        size_t i = index(x, y, z);
+        if (filled) bits[i >> 6] |= 1ull << (i & 63);
+        else bits[i >> 6] &= ~(1ull << (i & 63));
+    }
+};
+
 namespace std {
     template <>
     struct less<glm::vec3> {
@@ -62,38 +122,107 @@ protected:
     VoxelizationMethod method;
 
     std::vector<VoxelData> voxels; // Liste des voxels
-    GLuint VAO, VBO;           // Buffers OpenGL pour les voxels
+    GLuint VAO = 0, VBO = 0;   // Buffers OpenGL pour les voxels, créés une seule fois
+    size_t voxelBufferSize = 0; // Nombre de voxels alloués dans VBO
+    bool voxelBufferValid = false; // VBO à jour (envoyé seulement pour le geometry shader)
+    std::vector<size_t> dirtyVoxels; // Voxels modifiés depuis le dernier envoi
     glm::vec3 color {1.f, 1.f, 1.f};
 
     std::vector<glm::vec3> activeCorner; 
     VoxelData *selectedVoxel;
 
+    // Rendu instancié : liste compacte des voxels pleins, reconstruite quand toute la grille change
+    // et corrigée emplacement par emplacement lors des éditions
+    static bool instancedRendering;
+    static GLuint cubeVBO;      // Cube unité (36 sommets, position + normale), partagé par toutes les grilles
+    GLuint instanceVAO = 0, instanceVBO = 0;
+    size_t instanceCount = 0;
+    size_t instanceCapacity = 0;
+    bool instancesDirty = true;
+    std::vector<VoxelInstance> instanceData;    // Copie CPU de instanceVBO
+    std::vector<size_t> instanceVoxels;         // Emplacement -> indice du voxel
+    std::vector<int> instanceSlots;             // Indice du voxel -> emplacement (-1 si absent)
+
+    // Vertex pulling : 4 octets par voxel au lieu de 24, par blocs reconstruits indépendamment
+    static bool packedRendering;
+    VoxelChunks chunks;
+
+    static bool isInstanceVisible(const VoxelData& voxel);
+    static VoxelInstance makeInstance(const VoxelData& voxel);
+    void rebuildInstances();
+    void uploadDirtyVoxels();   // Envoie les seules plages modifiées (VBO et instances)
+    void uploadInstances(const std::vector<VoxelInstance>& instances);
+    void drawInstances(const Shader& shader, const glm::mat4& transformMat);
+    void uploadVoxelBuffer();   // Tous les VoxelData, lus uniquement par le geometry shader
+    void drawPackedVoxels(const Shader& shader, const glm::mat4& transformMat);
+
+    // Grilles régulières uniquement : voxels rangés x * Y * Z + y * Z + z, taille unique
+    virtual bool canPackVoxels() const { return false; }
+    virtual glm::ivec3 getGridSize() const { return glm::ivec3(0); }
+    virtual float getPackedVoxelSize() const { return 0.f; }
+
 public:
     Grid() {};
     Grid(const glm::vec3& minBounds, const glm::vec3& maxBounds, int resolution, VoxelizationMethod method)
         : minBounds(minBounds), maxBounds(maxBounds), resolution(resolution), method(method) {
         }
 
-    void initializeBuffers();    // Prépare les buffers OpenGL
+    Grid(const Grid&) = delete;
+    Grid& operator=(const Grid&) = delete;
+
+    void initializeBuffers();    // Envoie tous les voxels (création des buffers au premier appel)
+    void markVoxelDirty(const VoxelData& voxel) {
+        size_t index = &voxel - voxels.data();
+        dirtyVoxels.push_back(index);
+        chunks.markDirty(index);
+    }
+    // Début de frame : blocs reconstruits envoyés au GPU, blocs modifiés relancés
+    void updateChunks() { if (usesPackedRendering()) chunks.update(voxels); }
+    static void setupVoxelAttributes(); // Layout des attributs VoxelData pour le VBO actuellement lié
+
+    // Voxels pleins et voxel sélectionné
+    const std::vector<VoxelInstance>& getInstances() const { return instanceData; }
+    static bool& isInstancedRendering() { return instancedRendering; }
+    static bool& isPackedRendering() { return packedRendering; }
+    // Vrai si draw attend le shader voxel_packed_vertex_shader.glsl
+    bool usesPackedRendering() const { return instancedRendering && packedRendering && canPackVoxels(); }
+    size_t getInstanceCount() const { return usesPackedRendering() ? chunks.getVoxelCount() : instanceCount; }
+    size_t getChunkCount() const { return usesPackedRendering() ? chunks.getChunkCount() : 0; }
 
     void printGrid() const;
-    void draw(GLuint shaderID, glm::mat4 transformMat = glm::mat4(1.0f)); // Rendu des voxels via un shader
+    virtual void draw(const Shader& shader, glm::mat4 transformMat = glm::mat4(1.0f)); // Rendu des voxels via un shader
+    // Mise à jour dépendante de la vue (niveau de détail), appelée une fois par frame
+    // (grilles régulières : culling des blocs VoxelChunks)
+    virtual void updateLOD(const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection, float viewportHeight);
+    // Blocs de voxels hors champ à la dernière mise à jour
+    virtual size_t getCulledBrickCount() const { return usesPackedRendering() ? chunks.getCulledCount() : 0; }
     bool triangleIntersectsAABB(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2,
                                          const glm::vec3& boxCenter, const glm::vec3& boxHalfSize) const;
     bool testAxis(const glm::vec3& axis, const glm::vec3& t0, const glm::vec3& t1, const glm::vec3& t2,
                            const glm::vec3& boxHalfSize) const;
     void setColor(glm::vec3 c);
+    const glm::vec3& getColor() const { return color; }
+    const glm::vec3& getMinBounds() const { return minBounds; }
+    const glm::vec3& getMaxBounds() const { return maxBounds; }
+    int getResolution() const { return resolution; }
+    VoxelizationMethod getMethod() const { return method; }
     virtual void update(float deltaTime, GLFWwindow* window) {
         std::cerr << "Marching Cubes not implemented." << std::endl;
     }
 
-    virtual void marchingCube( std::vector<unsigned short> &indices, std::vector<glm::vec3> &vertices) {
+    virtual void marchingCube( std::vector<unsigned int> &indices, std::vector<glm::vec3> &vertices) {
         std::cerr << "Marching Cubes not implemented." << std::endl;
     }
     void removeDuplicates(std::vector<glm::vec3>& activeCorner);
-    void createOffFile(std::vector<unsigned short> &indices, std::vector<glm::vec3> &vertices, std::string& filename);
-
-    virtual ~Grid() = default;
+    // Soude une soupe de triangles (3 sommets consécutifs par triangle) en sommets indexés
+    static void weldTriangles(const std::vector<glm::vec3>& triangles, float epsilon,
+                              std::vector<unsigned int>& indices, std::vector<glm::vec3>& vertices);
+    void createOffFile(std::vector<unsigned int> &indices, std::vector<glm::vec3> &vertices, std::string& filename);
+    // Exports binaires (petit-boutiste), écrits par blocs
+    bool createPlyFile(const std::vector<unsigned int> &indices, const std::vector<glm::vec3> &vertices, const std::string& filename);
+    bool createStlFile(const std::vector<unsigned int> &indices, const std::vector<glm::vec3> &vertices, const std::string& filename);
+
+    virtual ~Grid();
 };
 
 #endif
@@ -67,6 +67,7 @@ void Interface::addGameObject(float _deltaTime, GLFWwindow* _window){
     if (ImGui::Button("Select Mesh")) {
         IGFD::FileDialogConfig config;
         config.path = "../data/meshes";
+        config.sidePane = AssetIndex::fileDialogPane;
         ImGuiFileDialog::Instance()->OpenDialog("ChooseMeshDlgKey", "Choose Mesh File", ".off", config);
     }
 
@@ -86,11 +87,13 @@ void Interface::addGameObject(float _deltaTime, GLFWwindow* _window){
     }
 
     ImGui::Text("Selected Mesh File: %s", meshPath.c_str());
+    AssetIndex::drawAssetInfo(meshPath);
 
     // Chemin pour la texture
     if (ImGui::Button("Select Texture")) {
         IGFD::FileDialogConfig config;
             config.path = "../data/textures";
+            config.sidePane = AssetIndex::fileDialogPane;
         ImGuiFileDialog::Instance()->OpenDialog("ChooseFileDlgTextureKey", "Choose File", ".png, .jpg, .bmp", config);
     }
     if (ImGuiFileDialog::Instance()->Display("ChooseFileDlgTextureKey")) {
@@ -110,6 +113,7 @@ void Interface::addGameObject(float _deltaTime, GLFWwindow* _window){
     
 
     ImGui::Text("Selected Texture File: %s", texturePath.c_str());
+    AssetIndex::drawAssetInfo(texturePath);
 
     if (texturePath.empty()) {
         ImGui::Text("Color RGB (0-256)");
@@ -212,11 +216,16 @@ void Interface::addGameObject(float _deltaTime, GLFWwindow* _window){
             ImGui::OpenPopup("ErreurMesh");
         } else {
         
-            GLuint textureID = texturePath.empty() ? 0 : loadTexture2DFromFilePath(texturePath);
-            glUniform1i(glGetUniformLocation(shader.ID, "gameObjectTexture"), 0);
+            // Décodage en arrière-plan, texture partagée si le fichier est déjà chargé
+            GLuint textureID = texturePath.empty() ? 0 : TextureCache::instance().acquireAsync(texturePath);
+            shader.setInt("gameObjectTexture", 0);
             GameObject* newObject;
         
-            newObject = new Mesh(name, meshPath.c_str(), textureID, texturePath.c_str(), shader);
+            // Analyse du fichier en arrière-plan, l'objet apparaît dès la fin du chargement
+            Mesh* newMesh = new Mesh(name, textureID, texturePath.c_str(), shader);
+            newMesh->setCachedTexture(textureID);
+            newMesh->loadModelAsync(meshPath);
+            newObject = newMesh;
             newObject->setMaterial(material); 
             
             
@@ -261,13 +270,45 @@ void voxelInterface(Mesh* mesh){
     // Liste des méthodes de voxélisation
     static int selectedMethod = 0; // Indice de la méthode sélectionnée
     
+    static bool buildBottomUp = false; // Octree adaptatif construit depuis une grille régulière
+    static bool errorDriven = false;   // Subdivision guidée par l'erreur de planéité
+    static float planarTolerance = 0.01f;
+    static int nodeBudget = 100000;
+
     ImGui::Text("Méthodes de voxélisation");
-    if(mesh->getGridType() == GridType::Regular){
+    if(mesh->getGridType() == GridType::Adaptative){
+        ImGui::Checkbox(("Construction ascendante ##" + std::to_string(mesh->getId())).c_str(), &buildBottomUp);
+        if (!buildBottomUp) {
+            ImGui::Checkbox(("Subdivision guidée par l'erreur ##" + std::to_string(mesh->getId())).c_str(), &errorDriven);
+            if (errorDriven) {
+                ImGui::DragFloat(("Tolérance de planéité ##" + std::to_string(mesh->getId())).c_str(), &planarTolerance, 0.0005f, 0.0f, 1.0f, "%.4f");
+                ImGui::InputInt(("Budget de nœuds ##" + std::to_string(mesh->getId())).c_str(), &nodeBudget, 1000, 10000);
+                nodeBudget = std::max(nodeBudget, 9);
+            }
+        }
+    }
+    if(mesh->getGridType() == GridType::Regular || buildBottomUp){
         const char* voxelMethods[] = { "Optimized", "Simple", "Surface" };
         ImGui::Combo(("##" + std::to_string(mesh->getId()) + "VoxelMethod").c_str(), &selectedMethod, voxelMethods, IM_ARRAYSIZE(voxelMethods));
 
     }
 
+    // Estimation à partir de l'index des assets, sans toucher au maillage
+    AssetInfo meshInfo;
+    if (AssetIndex::instance().find(mesh->getMeshPath(), meshInfo) && meshInfo.kind == AssetInfo::MeshAsset) {
+        VoxelizationMethod estimatedMethod = (selectedMethod == 0) ? VoxelizationMethod::Optimized :
+                                             (selectedMethod == 1) ? VoxelizationMethod::Simple :
+                                             VoxelizationMethod::Surface;
+        bool adaptative = mesh->getGridType() == GridType::Adaptative && !buildBottomUp;
+        VoxelizationEstimate estimate = AssetIndex::estimateVoxelization(meshInfo.minBounds, meshInfo.maxBounds, meshInfo.faceCount,
+                                                                         mesh->getVoxelResolution(), estimatedMethod, adaptative);
+        ImVec4 estimateColor = (estimate.seconds > 2.0f || estimate.memoryBytes > (512u << 20)) ? ImVec4(1.0f, 0.6f, 0.2f, 1.0f)
+                                                                                                : ImVec4(0.7f, 0.7f, 0.7f, 1.0f);
+        ImGui::TextColored(estimateColor, "Estimation : %dx%dx%d, ~%.1f Mo, ~%.2f s",
+                           estimate.gridSize.x, estimate.gridSize.y, estimate.gridSize.z,
+                           estimate.memoryBytes / (1024.0 * 1024.0), estimate.seconds);
+    }
+
     // Bouton pour voxeliser
     if (ImGui::Button(("Voxeliser ##" + std::to_string(mesh->getId())).c_str())) {
         if (mesh->getVoxelResolution() > 0) {
@@ -277,6 +318,12 @@ void voxelInterface(Mesh* mesh){
 
             if (mesh->getGridType() == GridType::Regular) {
                 mesh->setGrid(std::make_unique<RegularGrid>(mesh->getIndices(), mesh->getVertices(), mesh->getVoxelResolution(), method));
+            } else if (!buildBottomUp && errorDriven) {
+                mesh->setGrid(std::make_unique<AdaptativeGrid>(mesh->getIndices(), mesh->getVertices(), mesh->getVoxelResolution(),
+                                                               planarTolerance, static_cast<size_t>(nodeBudget)));
+            } else if (buildBottomUp) {
+                RegularGrid regularGrid(mesh->getIndices(), mesh->getVertices(), mesh->getVoxelResolution(), method);
+                mesh->setGrid(std::make_unique<AdaptativeGrid>(regularGrid.getOccupancy(), method));
             } else {
                 mesh->setGrid(std::make_unique<AdaptativeGrid>(mesh->getIndices(), mesh->getVertices(), mesh->getVoxelResolution(), method));
             }
@@ -287,6 +334,38 @@ void voxelInterface(Mesh* mesh){
         }
     }
 
+    // Voxelisation enregistrée (.vxg) : rechargée sans relancer le voxeliseur
+    static char gridFilename[128] = "../data/meshes/output.vxg";
+    ImGui::InputText(("Fichier de grille ##" + std::to_string(mesh->getId())).c_str(), gridFilename, IM_ARRAYSIZE(gridFilename));
+    if (mesh->isGridInitialized()) {
+        ImGui::SameLine();
+        if (ImGui::Button(("Sauvegarder ##grid" + std::to_string(mesh->getId())).c_str())) {
+            VoxelGridFile::save(gridFilename, *mesh->getGrid());
+        }
+    }
+    ImGui::SameLine();
+    if (ImGui::Button(("Charger ##grid" + std::to_string(mesh->getId())).c_str())) {
+        std::unique_ptr<Grid> grid = VoxelGridFile::load(gridFilename);
+        if (grid) {
+            mesh->setGridType(dynamic_cast<AdaptativeGrid*>(grid.get()) ? GridType::Adaptative : GridType::Regular);
+            mesh->setGrid(std::move(grid));
+            mesh->setShowVoxel(true);
+            mesh->setGridInitialized(true);
+        }
+    }
+
+    AdaptativeGrid* adaptativeGrid = mesh->isGridInitialized() ? dynamic_cast<AdaptativeGrid*>(mesh->getGrid()) : nullptr;
+    if (adaptativeGrid != nullptr) {
+        if (ImGui::Button(("Équilibrer 2:1 ##" + std::to_string(mesh->getId())).c_str())) {
+            adaptativeGrid->balance();
+        }
+        ImGui::Checkbox(("LOD dépendant de la vue ##" + std::to_string(mesh->getId())).c_str(), &adaptativeGrid->isLODEnabled());
+        if (adaptativeGrid->isLODEnabled()) {
+            ImGui::SliderFloat(("Seuil LOD (pixels) ##" + std::to_string(mesh->getId())).c_str(), &adaptativeGrid->getLODThreshold(), 1.0f, 64.0f);
+            ImGui::Text("Voxels affichés : %zu", adaptativeGrid->getLODVoxelCount());
+        }
+    }
+
     if (mesh->isGridInitialized()){
         
         ImGui::Text("Color RGB (0-256)");
@@ -325,9 +404,9 @@ void voxelInterface(Mesh* mesh){
 
 void marchingCubeInterface(Mesh* mesh){
     ImGui::Separator();
-    ImGui::Text("Marching Cubes and OFF Export");
+    ImGui::Text("Marching Cubes and Export");
     static bool isMarchingCubeExecuted = false;
-    static std::vector<unsigned short> indices;
+    static std::vector<unsigned int> indices;
     static std::vector<glm::vec3> vertices;
 
     // Bouton pour exécuter l'algorithme Marching Cubes
@@ -347,17 +426,63 @@ void marchingCubeInterface(Mesh* mesh){
     }
     if (isMarchingCubeExecuted) {
         static char filename[128] = "../data/meshes/output.off";
+        static int exportFormat = 0;
+        const char* exportFormats[] = { "OFF", "PLY (binaire)", "STL (binaire)" };
+        const char* exportExtensions[] = { ".off", ".ply", ".stl" };
+
+        // Changement de format : l'extension du fichier suit
+        if (ImGui::Combo("Format", &exportFormat, exportFormats, IM_ARRAYSIZE(exportFormats))) {
+            std::string file = filename;
+            size_t dot = file.find_last_of('.');
+            if (dot != std::string::npos && file.find_first_of("/\\", dot) == std::string::npos) {
+                file.erase(dot);
+            }
+            file += exportExtensions[exportFormat];
+            strncpy(filename, file.c_str(), sizeof(filename) - 1);
+            filename[sizeof(filename) - 1] = '\0';
+        }
         ImGui::InputText("Filename", filename, IM_ARRAYSIZE(filename));
 
         ImGui::SameLine(); 
-        if (ImGui::Button("Export OFF File")) {
+        if (ImGui::Button("Export File")) {
             std::string file = filename;
-            mesh->getGrid()->createOffFile(indices, vertices, file);
+            if (exportFormat == 1) {
+                mesh->getGrid()->createPlyFile(indices, vertices, file);
+            } else if (exportFormat == 2) {
+                mesh->getGrid()->createStlFile(indices, vertices, file);
+            } else {
+                mesh->getGrid()->createOffFile(indices, vertices, file);
+            }
         }
     }
 }
 
 
+void dagInterface(Mesh* mesh){
+    AdaptativeGrid* adaptativeGrid = dynamic_cast<AdaptativeGrid*>(mesh->getGrid());
+    if (adaptativeGrid == nullptr) return;
+
+    ImGui::Separator();
+    ImGui::Text("Compression SVDAG");
+
+    if (ImGui::Button(("Compresser en DAG ##" + std::to_string(mesh->getId())).c_str())) {
+        adaptativeGrid->compressDAG();
+    }
+
+    // Porté par la grille : disparaît avec une nouvelle voxelisation ou un équilibrage
+    if (const SparseVoxelDAG* dag = adaptativeGrid->getDAG()) {
+        ImGui::Text("Noeuds octree : %zu, DAG : %zu mots (%.1f Ko)",
+                    dag->getSourceNodeCount(), dag->getNodeWordCount(), dag->getSizeInBytes() / 1024.0f);
+
+        static char filename[128] = "../data/meshes/output.svdag";
+        ImGui::InputText(("DAG Filename ##" + std::to_string(mesh->getId())).c_str(), filename, IM_ARRAYSIZE(filename));
+        ImGui::SameLine();
+        if (ImGui::Button(("Export DAG ##" + std::to_string(mesh->getId())).c_str())) {
+            dag->save(filename);
+        }
+    }
+}
+
 void Interface::updateInterface(float _deltaTime, GLFWwindow* _window)
 {
 
@@ -388,9 +513,17 @@ void Interface::updateInterface(float _deltaTime, GLFWwindow* _window)
 
                 if (isOpen) {
                     ImGui::Text("Object Name: %s", objectName.c_str());
+                    if (meshObject->isLoading()) {
+                        // Données pas encore prêtes : pas de voxelisation possible
+                        const char spinner[] = "|/-\\";
+                        ImGui::Text("%c Loading %s... (%.1f s)", spinner[static_cast<int>(ImGui::GetTime() * 8.0) % 4],
+                                    meshObject->getLoadingPath().c_str(), meshObject->getLoadingTime());
+                        continue;
+                    }
                     meshObject->updateInterfaceTransform(_deltaTime); 
                     voxelInterface(meshObject); 
                     if(meshObject->isGridInitialized()){marchingCubeInterface(meshObject);}
+                    if(meshObject->isGridInitialized()){dagInterface(meshObject);}
                 }
             }
             if (ImGui::CollapsingHeader("Add")) {
@@ -399,6 +532,37 @@ void Interface::updateInterface(float _deltaTime, GLFWwindow* _window)
 
             ImGui::EndTabItem();
         }
+        if (ImGui::BeginTabItem("Rendu")) {
+            ImGui::Checkbox("Meshes groupés (multi-draw)", &BatchRenderer::isEnabled());
+            if (BatchRenderer::isEnabled()) {
+                const BatchRenderer& batch = SM->getBatchRenderer();
+                ImGui::Text("%zu meshes en %zu appels (%s)", batch.getObjectCount(), batch.getDrawCallCount(),
+                            batch.usesMultiDrawIndirect() ? "indirect" : "base vertex");
+            }
+            ImGui::Checkbox("Voxels instanciés (sans geometry shader)", &Grid::isInstancedRendering());
+            if (Grid::isInstancedRendering()) {
+                ImGui::Checkbox("Voxels compactés (32 bits, grilles régulières)", &Grid::isPackedRendering());
+                size_t instanceCount = 0;
+                for (auto& object : SM->getObjects()) {
+                    if (object->isGridInitialized() && object->isShowVoxel()) instanceCount += object->getGrid()->getInstanceCount();
+                }
+                ImGui::Text("Voxels affichés : %zu", instanceCount);
+                if (Grid::isPackedRendering()) {
+                    size_t chunkCount = 0;
+                    for (auto& object : SM->getObjects()) {
+                        if (object->isGridInitialized() && object->isShowVoxel()) chunkCount += object->getGrid()->getChunkCount();
+                    }
+                    ImGui::Text("Blocs de %d³ voxels : %zu", VoxelChunks::CHUNK_SIZE, chunkCount);
+                }
+            }
+
+            const CullingStats& culling = SM->getCullingStats();
+            ImGui::Separator();
+            ImGui::Text("Meshes hors champ : %zu / %zu", culling.culledObjects, culling.objects);
+            ImGui::Text("Grilles hors champ : %zu / %zu", culling.culledGrids, culling.grids);
+            ImGui::Text("Blocs hors champ (nœuds LOD, blocs de voxels) : %zu", culling.culledBricks);
+            ImGui::EndTabItem();
+        }
         ImGui::EndTabBar();
     }
     ImGui::End();
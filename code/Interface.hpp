@@ -10,6 +10,8 @@
 #include "Camera.hpp"
 #include "Mesh.hpp"
 #include "SceneManager.hpp"
+#include "VoxelGridFile.hpp"
+#include "AssetIndex.hpp"
 
 class Interface
 {
@@ -0,0 +1,38 @@
+#ifndef MAPPED_FILE_HPP__
+#define MAPPED_FILE_HPP__
+
+#include <string>
+#include <cstddef>
+
+// Projection en lecture seule d'un fichier en mémoire (mmap / MapViewOfFile).
+// Le contenu reste valide tant que l'objet existe.
+class MappedFile {
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fileDescriptor = -1;
+#endif
+
+public:
+    MappedFile() {}
+    explicit MappedFile(const std::string& path) { open(path); }
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return data != nullptr; }
+    const char* getData() const { return data; }
+    size_t getSize() const { return size; }
+    const char* begin() const { return data; }
+    const char* end() const { return data + size; }
+};
+
+#endif
@@ -44,189 +44,122 @@ Mesh::Mesh(std::string name, const char *path, glm::vec4 color, Shader &shader)
 }
 
 
+Mesh::Mesh(std::string name, int textureID, const char *texturePath, Shader &shader)
+    : GameObject(name, textureID, Transform(), Material(), shader) 
+{
+    this->name = name;
+    strncpy(newName, name.c_str(), sizeof(newName) - 1); 
+    this->textureID = textureID;
+    this->shader = shader;
+    newtexturePath = texturePath; 
+    this->texturePath = newtexturePath.c_str(); // L'appelant ne garde pas forcément sa chaîne
+
+    // Buffers vides en attendant loadModelAsync
+    this->GenerateBuffers();
+}
+
+
 void Mesh::loadModel(const char *path) {
-    std::string extension = std::string(path).substr(std::string(path).find_last_of(".") + 1);
+    MeshData data;
+    if (loadMeshData(path, data)) {
+        vertices = std::move(data.vertices);
+        normals = std::move(data.normals);
+        uvs = std::move(data.uvs);
+        indices = std::move(data.indices);
+    }
+}
+
+bool Mesh::loadMeshData(const std::string &path, MeshData &data) {
+    // Projection refermée dès la copie : les buffers GPU sont créés depuis les vecteurs
+    MeshCache cache;
+    if (cache.open(path)) {
+        cache.copyTo(data);
+        return true;
+    }
 
+    std::string extension = path.substr(path.find_last_of(".") + 1);
+    bool loaded = false;
     if (extension == "obj") {
-        if (!loadOBJ(path)) {
+        loaded = MeshLoader::loadOBJ(path, data);
+        if (!loaded) {
             std::cerr << "Failed to load OBJ model." << std::endl;
         }
     } else if (extension == "off") {
-        if (!loadOFF(path)) {
+        loaded = MeshLoader::loadOFF(path, data);
+        if (loaded) {
+            // Calcul des coordonnées UV pour chaque sommet
+            data.uvs.reserve(data.vertices.size());
+            for (const glm::vec3 &position : data.vertices) {
+                // Exemple simple : on utilise la position en X et Y pour définir les coordonnées UV
+                float u = (position.x + 1.0f) / 2.0f; // Normalisation pour l'UV
+                float v = (position.y + 1.0f) / 2.0f;
+                data.uvs.push_back(glm::vec2(u, v)); // Ajouter la coordonnée UV
+            }
+        } else {
             std::cerr << "Failed to load OFF model." << std::endl;
         }
     } else {
         std::cerr << "Unsupported file format." << std::endl;
     }
-}
-bool Mesh::loadOBJ(const char *path) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open file: " << path << std::endl;
-        return false;
-    }
-
-    std::vector<glm::vec3> temp_vertices;
-    std::vector<glm::vec3> temp_normals; // Pour stocker les normales
-    std::vector<glm::vec2> temp_uvs;
-
-    std::string line;
-    while (std::getline(file, line)) {
-        std::istringstream ss(line);
-        std::string type;
-        ss >> type;
-
-        if (type == "v") {  // Position du sommet
-            glm::vec3 position;
-            ss >> position.x >> position.y >> position.z;
-            temp_vertices.push_back(position);
-        }
-        else if (type == "vn") {  // Normale du sommet
-            glm::vec3 normal;
-            ss >> normal.x >> normal.y >> normal.z;
-            temp_normals.push_back(normal);
-        }
-        else if (type == "vt") {  // Coordonnées de texture
-            glm::vec2 texCoord;
-            ss >> texCoord.x >> texCoord.y;
-            temp_uvs.push_back(texCoord);
-        }
-        else if (type == "f") {  // Définition de la face
-            unsigned int posIdx[3], uvIdx[3], normIdx[3];
-            char slash;
-            for (int i = 0; i < 3; i++) {
-                ss >> posIdx[i] >> slash >> uvIdx[i] >> slash >> normIdx[i];
-                posIdx[i]--; uvIdx[i]--; normIdx[i]--;  // Conversion à l'indexation C++
-                indices.push_back(posIdx[i]);
-            }
-
-            // Calcul des normales pour chaque face
-            glm::vec3 v0 = temp_vertices[posIdx[0]];
-            glm::vec3 v1 = temp_vertices[posIdx[1]];
-            glm::vec3 v2 = temp_vertices[posIdx[2]];
 
-            glm::vec3 edge1 = v1 - v0;
-            glm::vec3 edge2 = v2 - v0;
-            glm::vec3 faceNormal = glm::normalize(glm::cross(edge1, edge2));
-
-            // Ajout de la normale aux sommets (on ajoutera la normale à la fin dans normals)
-            for (int i = 0; i < 3; i++) {
-                normals.push_back(faceNormal);
-            }
-        }
+    // Premier chargement : écriture du cache à côté de la source
+    if (loaded && !MeshCache::write(path, data)) {
+        std::cerr << "Mesh cache not written for " << path << std::endl;
     }
+    return loaded;
+}
 
-    // Si les normales sont fournies dans le fichier, on les utilise
-    if (temp_normals.empty()) {
-        // Si les normales ne sont pas présentes, calculer les normales des sommets
-        normals.clear();
-        normals.resize(temp_vertices.size(), glm::vec3(0.0f));  // Initialiser les normales
-
-        // Calculer la normale de chaque sommet à partir des faces
-        for (size_t i = 0; i < indices.size(); i += 3) {
-            glm::vec3 v0 = temp_vertices[indices[i]];
-            glm::vec3 v1 = temp_vertices[indices[i + 1]];
-            glm::vec3 v2 = temp_vertices[indices[i + 2]];
-
-            glm::vec3 edge1 = v1 - v0;
-            glm::vec3 edge2 = v2 - v0;
-            glm::vec3 faceNormal = glm::normalize(glm::cross(edge1, edge2));
-
-            // Ajouter la normale de la face à chaque sommet de la face
-            normals[indices[i]] += faceNormal;
-            normals[indices[i + 1]] += faceNormal;
-            normals[indices[i + 2]] += faceNormal;
-        }
-
-        // Normaliser les normales de chaque sommet
-        for (auto &normal : normals) {
-            normal = glm::normalize(normal);
-        }
-    } else {
-        // Sinon, on utilise les normales déjà présentes dans le fichier
-        normals = temp_normals;
+void Mesh::loadModelAsync(const std::string &path) {
+    // Un seul chargement retenu par mesh : le précédent n'est pas attendu, son résultat sera ignoré
+    if (pendingLoad.valid()) {
+        staleLoads.push_back(std::move(pendingLoad));
     }
 
-    // Copier les sommets, coordonnées de texture et normales dans les vecteurs finaux
-    vertices = temp_vertices;
-    uvs = temp_uvs;
-
-    file.close();
-    return true;
+    pendingPath = path;
+    loadStart = std::chrono::steady_clock::now();
+    pendingLoad = std::async(std::launch::async, [path]() {
+        std::unique_ptr<MeshData> data(new MeshData());
+        if (!loadMeshData(path, *data)) {
+            data.reset();
+        }
+        return data;
+    });
 }
 
-bool Mesh::loadOFF(const char *path) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open file: " << path << std::endl;
-        return false;
-    }
+void Mesh::setMeshData(MeshData &data, const std::string &path) {
+    meshPath = path;
+    vertices = std::move(data.vertices);
+    normals = std::move(data.normals);
+    uvs = std::move(data.uvs);
+    indices = std::move(data.indices);
+    DeleteBuffers();
+    this->GenerateBuffers();
+}
 
-    std::string header;
-    file >> header;
-    if (header != "OFF") {
-        std::cerr << "Not a valid OFF file." << std::endl;
-        return false;
-    }
+bool Mesh::isLoading() const {
+    return pendingLoad.valid();
+}
 
-    int vertexCount, faceCount, edgeCount;
-    file >> vertexCount >> faceCount >> edgeCount;
+float Mesh::getLoadingTime() const {
+    return std::chrono::duration<float>(std::chrono::steady_clock::now() - loadStart).count();
+}
 
-    // Réserver l'espace pour les sommets
-    vertices.reserve(vertexCount);
-    for (int i = 0; i < vertexCount; i++) {
-        glm::vec3 position;
-        file >> position.x >> position.y >> position.z;
-        vertices.push_back(position);
-    }
-    normals.resize(vertices.size(), glm::vec3(0.0f));
-
-    // Lecture des faces
-    for (int i = 0; i < faceCount; i++) {
-        int numVertices;
-        file >> numVertices;
-        if (numVertices != 3) {  // Vérification que c'est un triangle
-            std::cerr << "Only triangular faces are supported." << std::endl;
-            return false;
+void Mesh::update(float deltaTime) {
+    // Le destructeur d'un future de std::async attend la fin du thread : on ne libère que les chargements terminés
+    staleLoads.erase(std::remove_if(staleLoads.begin(), staleLoads.end(), [](const std::future<std::unique_ptr<MeshData>>& load) {
+        return load.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }), staleLoads.end());
+
+    // Fin d'un chargement asynchrone : seul l'envoi GPU se fait sur le thread de rendu
+    if (pendingLoad.valid() && pendingLoad.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        std::unique_ptr<MeshData> data = pendingLoad.get();
+        if (data) {
+            setMeshData(*data, pendingPath);
+        } else {
+            std::cerr << "Asynchronous loading failed: " << pendingPath << std::endl;
         }
-
-        unsigned int faceIdx[3];
-        file >> faceIdx[0] >> faceIdx[1] >> faceIdx[2];
-        indices.push_back(faceIdx[0]);
-        indices.push_back(faceIdx[1]);
-        indices.push_back(faceIdx[2]);
-
-        // Calcul de la normale de la face
-        glm::vec3 v0 = vertices[faceIdx[0]];
-        glm::vec3 v1 = vertices[faceIdx[1]];
-        glm::vec3 v2 = vertices[faceIdx[2]];
-
-        glm::vec3 edge1 = v1 - v0;
-        glm::vec3 edge2 = v2 - v0;
-        glm::vec3 faceNormal = glm::normalize(glm::cross(edge1, edge2));
-
-        // Ajouter la normale de la face aux normales des sommets
-        normals[faceIdx[0]] += faceNormal;
-        normals[faceIdx[1]] += faceNormal;
-        normals[faceIdx[2]] += faceNormal;
-    }
-
-    // Normaliser les normales des sommets
-    for (auto &normal : normals) {
-        normal = glm::normalize(normal);
     }
-
-    // Calcul des coordonnées UV pour chaque sommet
-    for (int i = 0; i < vertexCount; i++) {
-        glm::vec3 position = vertices[i];
-        // Exemple simple : on utilise la position en X et Y pour définir les coordonnées UV
-        float u = (position.x + 1.0f) / 2.0f; // Normalisation pour l'UV
-        float v = (position.y + 1.0f) / 2.0f;
-        uvs.push_back(glm::vec2(u, v)); // Ajouter la coordonnée UV
-    }
-
-    file.close();
-    return true;
+    GameObject::update(deltaTime);
 }
 
 
@@ -246,18 +179,13 @@ void Mesh::updateInterfaceTransform(float _deltaTime){
         if (ImGui::Button(("Select Mesh ##" + std::to_string(id)).c_str())) {
             IGFD::FileDialogConfig config;
             config.path = "../data/meshes";
+            config.sidePane = AssetIndex::fileDialogPane;
             ImGuiFileDialog::Instance()->OpenDialog(("##" + std::to_string(id) + " Mesh").c_str(), "Choose Mesh File", ".off,.obj", config);
         }
 
         if (ImGuiFileDialog::Instance()->Display(("##" + std::to_string(id) + " Mesh").c_str())) {
             if (ImGuiFileDialog::Instance()->IsOk()) {
-                meshPath = ImGuiFileDialog::Instance()->GetFilePathName();
-                indices.clear();
-                vertices.clear();
-                uvs.clear();
-                normals.clear();
-                loadModel(meshPath.c_str());
-                this->GenerateBuffers();
+                loadModelAsync(ImGuiFileDialog::Instance()->GetFilePathName());
             }
             ImGuiFileDialog::Instance()->Close();
         }
@@ -268,13 +196,14 @@ void Mesh::updateInterfaceTransform(float _deltaTime){
         if (ImGui::Button(("Select Texture ##" + std::to_string(id)).c_str())) {
             IGFD::FileDialogConfig config;
             config.path = "../data/textures";
+            config.sidePane = AssetIndex::fileDialogPane;
             ImGuiFileDialog::Instance()->OpenDialog(("##" + std::to_string(id) + " Texture").c_str(), "Choose Texture File", ".png,.jpg,.bmp", config);
         }
 
         if (ImGuiFileDialog::Instance()->Display(("##" + std::to_string(id) + " Texture").c_str())) {
             if (ImGuiFileDialog::Instance()->IsOk()) {
                 newtexturePath = ImGuiFileDialog::Instance()->GetFilePathName();
-                textureID = loadTexture2DFromFilePath(newtexturePath.c_str());
+                setCachedTexture(TextureCache::instance().acquireAsync(newtexturePath));
             }
             ImGuiFileDialog::Instance()->Close();
         }
@@ -282,7 +211,7 @@ void Mesh::updateInterfaceTransform(float _deltaTime){
         if(newtexturePath != "" ){
             if (ImGui::Button(("Cancel texture ##" + std::to_string(id)).c_str())){
                 newtexturePath = ""; 
-                textureID = 0; 
+                releaseTexture();
             }
         }
 
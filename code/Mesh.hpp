@@ -11,11 +11,17 @@
 #include <sstream>
 #include <vector>
 #include <string>
+#include <future>
+#include <chrono>
+#include <algorithm>
 #include <glm/glm.hpp>
 #include <GL/glew.h>
 
 #include "GameObject.hpp"
 #include "Shader.hpp"
+#include "MeshLoader.hpp"
+#include "MeshCache.hpp"
+#include "AssetIndex.hpp"
 
 class Mesh : public GameObject {
 private :
@@ -24,15 +30,32 @@ private :
     char newName[128]; 
     std::string meshPath; 
     std::string newtexturePath;
+
+    // Chargement asynchrone : analyse sur un thread de travail, envoi GPU dans update()
+    std::future<std::unique_ptr<MeshData>> pendingLoad;
+    std::vector<std::future<std::unique_ptr<MeshData>>> staleLoads;  // Chargements remplacés, abandonnés une fois terminés
+    std::string pendingPath;
+    std::chrono::steady_clock::time_point loadStart;
     
 
 public :
     Mesh(std::string name, const char *path, int textureID, const char *texturePath, Shader &shader);
     Mesh(std::string name, const char *path, glm::vec4 color, Shader &shader);
+    Mesh(std::string name, int textureID, const char *texturePath, Shader &shader); // Mesh vide, rempli par loadModelAsync
 
     void loadModel(const char *path);
-    bool loadOBJ(const char *path);
-    bool loadOFF(const char *path);
+    void setMeshData(MeshData &data, const std::string &path); // Remplace les données et les buffers GPU
+    // Sans appel OpenGL : utilisable depuis un thread de travail
+    static bool loadMeshData(const std::string &path, MeshData &data);
+
+    void loadModelAsync(const std::string &path);
+    bool isLoading() const;
+    float getLoadingTime() const;
+    const std::string& getLoadingPath() const { return pendingPath; }
+    const std::string& getMeshPath() const { return isLoading() ? pendingPath : meshPath; }
+    const std::string& getTexturePath() const { return newtexturePath; }
+
+    void update(float deltaTime) override;
     void updateInterfaceTransform(float _deltaTime);
     void draw(Shader &shader);
 
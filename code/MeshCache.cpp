@@ -0,0 +1,147 @@
+#include "MeshCache.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <functional>
+
+namespace {
+    const char CACHE_MAGIC[4] = {'M', 'S', 'H', 'C'};
+    const uint32_t CACHE_VERSION = 1;
+    static_assert(sizeof(MeshCache::Header) == 72, "L'en-tête du cache doit rester sans remplissage");
+
+    uint64_t hashBytes(const char* data, size_t size) {
+        uint64_t h = 1469598103934665603ull;
+        for (size_t i = 0; i < size; ++i) {
+            h ^= static_cast<unsigned char>(data[i]);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    bool sourceStatus(const std::string& sourcePath, uint64_t& size, int64_t& time) {
+        std::error_code error;
+        size = std::filesystem::file_size(sourcePath, error);
+        if (error) return false;
+        time = static_cast<int64_t>(std::filesystem::last_write_time(sourcePath, error).time_since_epoch().count());
+        return !error;
+    }
+
+    size_t payloadSize(const MeshCache::Header& header) {
+        return header.vertexCount * sizeof(glm::vec3) + header.normalCount * sizeof(glm::vec3)
+             + header.uvCount * sizeof(glm::vec2) + header.indexCount * sizeof(unsigned short);
+    }
+}
+
+std::string MeshCache::cachePath(const std::string& sourcePath) {
+    return sourcePath + ".meshcache";
+}
+
+bool MeshCache::write(const std::string& sourcePath, const MeshData& mesh) {
+    Header header = {};
+    std::copy(CACHE_MAGIC, CACHE_MAGIC + 4, header.magic);
+    header.version = CACHE_VERSION;
+    if (!sourceStatus(sourcePath, header.sourceSize, header.sourceTime)) return false;
+
+    MappedFile source(sourcePath);
+    if (!source.isOpen()) return false;
+    header.sourceHash = hashBytes(source.getData(), source.getSize());
+
+    header.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    header.normalCount = static_cast<uint32_t>(mesh.normals.size());
+    header.uvCount = static_cast<uint32_t>(mesh.uvs.size());
+    header.indexCount = static_cast<uint32_t>(mesh.indices.size());
+    header.minBounds = glm::vec3(std::numeric_limits<float>::max());
+    header.maxBounds = glm::vec3(std::numeric_limits<float>::lowest());
+    for (const glm::vec3& vertex : mesh.vertices) {
+        header.minBounds = glm::min(header.minBounds, vertex);
+        header.maxBounds = glm::max(header.maxBounds, vertex);
+    }
+    if (mesh.vertices.empty()) header.minBounds = header.maxBounds = glm::vec3(0.0f);
+
+    // Écriture dans un fichier temporaire puis renommage : un cache n'est jamais lu à moitié écrit
+    std::string path = cachePath(sourcePath);
+    // Suffixe propre au thread : plusieurs chargements peuvent écrire le même cache
+    std::string temporaryPath = path + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    {
+        std::ofstream outFile(temporaryPath, std::ios::binary);
+        if (!outFile) {
+            std::cerr << "Impossible d'écrire le cache " << path << std::endl;
+            return false;
+        }
+        outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        outFile.write(reinterpret_cast<const char*>(mesh.vertices.data()), mesh.vertices.size() * sizeof(glm::vec3));
+        outFile.write(reinterpret_cast<const char*>(mesh.normals.data()), mesh.normals.size() * sizeof(glm::vec3));
+        outFile.write(reinterpret_cast<const char*>(mesh.uvs.data()), mesh.uvs.size() * sizeof(glm::vec2));
+        outFile.write(reinterpret_cast<const char*>(mesh.indices.data()), mesh.indices.size() * sizeof(unsigned short));
+        if (!outFile) {
+            std::cerr << "Impossible d'écrire le cache " << path << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error) {
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+    return true;
+}
+
+bool MeshCache::open(const std::string& sourcePath) {
+    close();
+
+    std::string path = cachePath(sourcePath);
+    std::error_code error;
+    if (!std::filesystem::exists(path, error)) return false;
+
+    uint64_t sourceSize;
+    int64_t sourceTime;
+    if (!sourceStatus(sourcePath, sourceSize, sourceTime) || !file.open(path)) return false;
+
+    const Header* mapped = reinterpret_cast<const Header*>(file.getData());
+    if (file.getSize() < sizeof(Header) || !std::equal(CACHE_MAGIC, CACHE_MAGIC + 4, mapped->magic)
+        || mapped->version != CACHE_VERSION || file.getSize() != sizeof(Header) + payloadSize(*mapped)
+        || mapped->sourceSize != sourceSize) {
+        file.close();
+        return false;
+    }
+
+    // Date différente (copie, checkout...) : le contenu fait foi
+    if (mapped->sourceTime != sourceTime) {
+        MappedFile source(sourcePath);
+        if (!source.isOpen() || hashBytes(source.getData(), source.getSize()) != mapped->sourceHash) {
+            file.close();
+            return false;
+        }
+    }
+
+    header = mapped;
+    const char* data = file.getData() + sizeof(Header);
+    vertices = reinterpret_cast<const glm::vec3*>(data);
+    data += header->vertexCount * sizeof(glm::vec3);
+    normals = reinterpret_cast<const glm::vec3*>(data);
+    data += header->normalCount * sizeof(glm::vec3);
+    uvs = reinterpret_cast<const glm::vec2*>(data);
+    data += header->uvCount * sizeof(glm::vec2);
+    indices = reinterpret_cast<const unsigned short*>(data);
+    return true;
+}
+
+void MeshCache::close() {
+    file.close();
+    header = nullptr;
+    vertices = nullptr;
+    normals = nullptr;
+    uvs = nullptr;
+    indices = nullptr;
+}
+
+void MeshCache::copyTo(MeshData& mesh) const {
+    mesh.vertices.assign(vertices, vertices + getVertexCount());
+    mesh.normals.assign(normals, normals + getNormalCount());
+    mesh.uvs.assign(uvs, uvs + getUVCount());
+    mesh.indices.assign(indices, indices + getIndexCount());
+}
@@ -0,0 +1,62 @@
+#ifndef MESH_CACHE_HPP__
+#define MESH_CACHE_HPP__
+
+#include <string>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "MappedFile.hpp"
+#include "MeshLoader.hpp"
+
+// Cache binaire d'un maillage, écrit à côté du fichier source (<source>.meshcache).
+// Disposition : en-tête fixe puis positions, normales, UVs et indices bruts,
+// lus sans analyse depuis la projection mémoire du fichier.
+class MeshCache {
+public:
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint64_t sourceSize;
+        int64_t sourceTime;         // Date de modification de la source
+        uint64_t sourceHash;        // FNV-1a du contenu de la source
+        uint32_t vertexCount;
+        uint32_t normalCount;
+        uint32_t uvCount;
+        uint32_t indexCount;
+        glm::vec3 minBounds;
+        glm::vec3 maxBounds;
+    };
+
+private:
+    MappedFile file;
+    const Header* header = nullptr;
+    const glm::vec3* vertices = nullptr;
+    const glm::vec3* normals = nullptr;
+    const glm::vec2* uvs = nullptr;
+    const unsigned short* indices = nullptr;
+
+public:
+    static std::string cachePath(const std::string& sourcePath);
+    static bool write(const std::string& sourcePath, const MeshData& mesh);
+
+    // Projette le cache de sourcePath s'il existe et correspond encore à la source
+    bool open(const std::string& sourcePath);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+
+    // Copie CPU des tableaux (nécessaire à la voxelisation)
+    void copyTo(MeshData& mesh) const;
+
+    const glm::vec3* getVertices() const { return vertices; }
+    const glm::vec3* getNormals() const { return normals; }
+    const glm::vec2* getUVs() const { return uvs; }
+    const unsigned short* getIndices() const { return indices; }
+    size_t getVertexCount() const { return header ? header->vertexCount : 0; }
+    size_t getNormalCount() const { return header ? header->normalCount : 0; }
+    size_t getUVCount() const { return header ? header->uvCount : 0; }
+    size_t getIndexCount() const { return header ? header->indexCount : 0; }
+    glm::vec3 getMinBounds() const { return header ? header->minBounds : glm::vec3(0.0f); }
+    glm::vec3 getMaxBounds() const { return header ? header->maxBounds : glm::vec3(0.0f); }
+};
+
+#endif
@@ -0,0 +1,494 @@
+#include "MeshLoader.hpp"
+#include "MappedFile.hpp"
+#include <charconv>
+#include <cstring>
+#include <thread>
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+
+namespace {
+    // En dessous de cette taille, le coût de création des threads domine
+    const size_t MIN_CHUNK_SIZE = 256 * 1024;
+
+    inline bool isBlank(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    inline const char* findLineEnd(const char* p, const char* end) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        return eol ? eol : end;
+    }
+
+    inline const char* nextLine(const char* eol, const char* end) {
+        return eol < end ? eol + 1 : end;
+    }
+
+    // Ligne utile : ni vide ni commentaire
+    inline bool isDataLine(const char* p, const char* eol) {
+        while (p < eol && isBlank(*p)) ++p;
+        return p < eol && *p != '#';
+    }
+
+    // Lit un nombre sur la ligne courante (ne franchit jamais un '\n')
+    template <typename T>
+    inline bool parseNumber(const char*& p, const char* eol, T& value) {
+        while (p < eol && isBlank(*p)) ++p;
+        if (p < eol && *p == '+') ++p;
+        std::from_chars_result result = std::from_chars(p, eol, value);
+        if (result.ec != std::errc()) return false;
+        p = result.ptr;
+        return true;
+    }
+
+    // Lecture de l'en-tête : mots séparés par des blancs, sauts de ligne ou commentaires
+    const char* skipHeaderSpace(const char* p, const char* end) {
+        while (p < end) {
+            if (isBlank(*p) || *p == '\n') {
+                ++p;
+            } else if (*p == '#') {
+                p = findLineEnd(p, end);
+            } else {
+                break;
+            }
+        }
+        return p;
+    }
+
+    unsigned resolveThreadCount(unsigned threadCount, size_t byteCount) {
+        if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+        return static_cast<unsigned>(std::min<size_t>(threadCount, std::max<size_t>(1, byteCount / MIN_CHUNK_SIZE)));
+    }
+
+    // Exécute task(i) pour i dans [0, count), un thread par tâche, le thread appelant traitant la dernière
+    template <typename Task>
+    void runParallel(size_t count, Task task) {
+        std::vector<std::thread> workers;
+        workers.reserve(count > 0 ? count - 1 : 0);
+        for (size_t i = 0; i + 1 < count; ++i) {
+            workers.emplace_back(task, i);
+        }
+        if (count > 0) task(count - 1);
+        for (auto& worker : workers) worker.join();
+    }
+
+    // Découpe [begin, end) en blocs dont chaque frontière est un début de ligne
+    std::vector<const char*> splitAtLines(const char* begin, const char* end, unsigned chunkCount) {
+        std::vector<const char*> bounds(chunkCount + 1, end);
+        bounds[0] = begin;
+        size_t step = (end - begin) / chunkCount;
+        for (unsigned i = 1; i < chunkCount; ++i) {
+            const char* p = std::max(bounds[i - 1], begin + i * step);
+            p = findLineEnd(p, end);
+            bounds[i] = (p < end) ? p + 1 : end;
+        }
+        return bounds;
+    }
+
+    // Compteurs d'éléments OBJ, par bloc puis cumulés
+    struct OBJCounts {
+        size_t positions = 0;
+        size_t uvs = 0;
+        size_t normals = 0;
+    };
+
+    enum class OBJLine { Position, UV, Normal, Face, Other };
+
+    // Type de la ligne ; p est placé après le mot-clé
+    OBJLine classifyOBJLine(const char*& p, const char* eol) {
+        while (p < eol && isBlank(*p)) ++p;
+        if (eol - p < 2 || !isBlank(p[1])) {
+            if (eol - p >= 3 && p[0] == 'v' && isBlank(p[2])) {
+                if (p[1] == 't') { p += 3; return OBJLine::UV; }
+                if (p[1] == 'n') { p += 3; return OBJLine::Normal; }
+            }
+            return OBJLine::Other;
+        }
+        if (p[0] == 'v') { p += 2; return OBJLine::Position; }
+        if (p[0] == 'f') { p += 2; return OBJLine::Face; }
+        return OBJLine::Other;
+    }
+
+    // Indice OBJ (1-based, ou négatif relatif au nombre d'éléments déjà lus) vers 0-based
+    inline bool resolveOBJIndex(long index, size_t definedCount, size_t totalCount, uint32_t& resolved) {
+        long long absolute = (index > 0) ? index - 1 : static_cast<long long>(definedCount) + index;
+        if (index == 0 || absolute < 0 || absolute >= static_cast<long long>(totalCount)) return false;
+        resolved = static_cast<uint32_t>(absolute);
+        return true;
+    }
+
+    // Un coin de face : indices résolus + 1 (0 = composante absente), 21 bits chacun
+    const int OBJ_INDEX_BITS = 21;
+    const size_t OBJ_MAX_ELEMENTS = (size_t(1) << OBJ_INDEX_BITS) - 1;
+
+    inline uint64_t packCorner(uint64_t position, uint64_t uv, uint64_t normal) {
+        return position | (uv << OBJ_INDEX_BITS) | (normal << (2 * OBJ_INDEX_BITS));
+    }
+
+    struct CornerHash {
+        size_t operator()(uint64_t key) const {
+            key ^= key >> 33;
+            key *= 0xff51afd7ed558ccdull;
+            key ^= key >> 33;
+            return static_cast<size_t>(key);
+        }
+    };
+}
+
+namespace MeshLoader {
+
+bool loadOFF(const std::string& path, MeshData& mesh, unsigned threadCount) {
+    MappedFile file(path);
+    if (!file.isOpen()) return false;
+    const char* p = file.begin();
+    const char* end = file.end();
+
+    // En-tête : [ST][C][N][4]OFF puis nombres de sommets, faces et arêtes
+    p = skipHeaderSpace(p, end);
+    const char* magic = p;
+    while (p < end && !isBlank(*p) && *p != '\n') ++p;
+    std::string header(magic, p);
+    if (header.size() < 3 || header.compare(header.size() - 3, 3, "OFF") != 0) {
+        std::cerr << "Not a valid OFF file." << std::endl;
+        return false;
+    }
+
+    long long counts[2];
+    for (long long& count : counts) {
+        p = skipHeaderSpace(p, end);
+        std::from_chars_result result = std::from_chars(p, end, count);
+        if (result.ec != std::errc() || count < 0) {
+            std::cerr << "Invalid OFF header: " << path << std::endl;
+            return false;
+        }
+        p = result.ptr;
+    }
+    // Le nombre d'arêtes, s'il est présent, est ignoré avec le reste de la ligne
+    p = findLineEnd(p, end);
+    if (p < end) ++p;
+
+    size_t vertexCount = static_cast<size_t>(counts[0]);
+    size_t faceCount = static_cast<size_t>(counts[1]);
+    if (vertexCount > std::numeric_limits<unsigned short>::max() + size_t(1)) {
+        std::cerr << "Too many vertices for 16-bit indices (" << vertexCount << "): " << path << std::endl;
+        return false;
+    }
+
+    unsigned chunkCount = resolveThreadCount(threadCount, end - p);
+    std::vector<const char*> bounds = splitAtLines(p, end, chunkCount);
+
+    // Passe 1 : nombre de lignes utiles par bloc, pour connaître l'indice global de chaque ligne
+    std::vector<size_t> firstLine(chunkCount + 1, 0);
+    runParallel(chunkCount, [&](size_t chunk) {
+        size_t lineCount = 0;
+        for (const char* line = bounds[chunk]; line < bounds[chunk + 1];) {
+            const char* eol = findLineEnd(line, bounds[chunk + 1]);
+            if (isDataLine(line, eol)) ++lineCount;
+            line = nextLine(eol, bounds[chunk + 1]);
+        }
+        firstLine[chunk + 1] = lineCount;
+    });
+    for (unsigned chunk = 0; chunk < chunkCount; ++chunk) firstLine[chunk + 1] += firstLine[chunk];
+    if (firstLine[chunkCount] < vertexCount + faceCount) {
+        std::cerr << "Truncated OFF file: " << path << std::endl;
+        return false;
+    }
+
+    // Passe 2 : sommets (seuls les trois premiers nombres sont lus, normales et couleurs ignorées)
+    mesh.vertices.resize(vertexCount);
+    std::vector<char> chunkFailed(chunkCount, 0);
+    runParallel(chunkCount, [&](size_t chunk) {
+        size_t lineIndex = firstLine[chunk];
+        for (const char* line = bounds[chunk]; line < bounds[chunk + 1] && lineIndex < vertexCount;) {
+            const char* eol = findLineEnd(line, bounds[chunk + 1]);
+            if (isDataLine(line, eol)) {
+                glm::vec3& vertex = mesh.vertices[lineIndex++];
+                const char* q = line;
+                if (!parseNumber(q, eol, vertex.x) || !parseNumber(q, eol, vertex.y) || !parseNumber(q, eol, vertex.z)) {
+                    chunkFailed[chunk] = 1;
+                    return;
+                }
+            }
+            line = nextLine(eol, bounds[chunk + 1]);
+        }
+    });
+    if (std::find(chunkFailed.begin(), chunkFailed.end(), 1) != chunkFailed.end()) {
+        std::cerr << "Invalid vertex in OFF file: " << path << std::endl;
+        return false;
+    }
+
+    // Passe 3 : faces, triangulées en éventail ; chaque bloc accumule ses normales
+    // dans son propre tableau pour éviter toute synchronisation
+    std::vector<std::vector<unsigned short>> chunkIndices(chunkCount);
+    std::vector<std::vector<glm::vec3>> chunkNormals(chunkCount);
+    runParallel(chunkCount, [&](size_t chunk) {
+        size_t lineIndex = firstLine[chunk];
+        size_t lastLine = vertexCount + faceCount;
+        if (firstLine[chunk + 1] <= vertexCount || lineIndex >= lastLine) return;
+
+        std::vector<unsigned short>& indices = chunkIndices[chunk];
+        std::vector<glm::vec3>& normals = chunkNormals[chunk];
+        indices.reserve((std::min(firstLine[chunk + 1], lastLine) - std::max(lineIndex, vertexCount)) * 3);
+        normals.assign(vertexCount, glm::vec3(0.0f));
+
+        for (const char* line = bounds[chunk]; line < bounds[chunk + 1] && lineIndex < lastLine;) {
+            const char* eol = findLineEnd(line, bounds[chunk + 1]);
+            if (!isDataLine(line, eol)) {
+                line = nextLine(eol, bounds[chunk + 1]);
+                continue;
+            }
+            if (lineIndex++ < vertexCount) {
+                line = nextLine(eol, bounds[chunk + 1]);
+                continue;
+            }
+
+            const char* q = line;
+            unsigned polygonSize, first, previous, current;
+            if (!parseNumber(q, eol, polygonSize) || polygonSize < 3 ||
+                !parseNumber(q, eol, first) || !parseNumber(q, eol, previous) ||
+                first >= vertexCount || previous >= vertexCount) {
+                chunkFailed[chunk] = 1;
+                return;
+            }
+            for (unsigned k = 2; k < polygonSize; ++k) {
+                if (!parseNumber(q, eol, current) || current >= vertexCount) {
+                    chunkFailed[chunk] = 1;
+                    return;
+                }
+                indices.push_back(static_cast<unsigned short>(first));
+                indices.push_back(static_cast<unsigned short>(previous));
+                indices.push_back(static_cast<unsigned short>(current));
+
+                glm::vec3 faceNormal = glm::cross(mesh.vertices[previous] - mesh.vertices[first],
+                                                  mesh.vertices[current] - mesh.vertices[first]);
+                float length = glm::length(faceNormal);
+                if (length > 0.0f) {
+                    faceNormal /= length;
+                    normals[first] += faceNormal;
+                    normals[previous] += faceNormal;
+                    normals[current] += faceNormal;
+                }
+                previous = current;
+            }
+            line = nextLine(eol, bounds[chunk + 1]);
+        }
+    });
+    if (std::find(chunkFailed.begin(), chunkFailed.end(), 1) != chunkFailed.end()) {
+        std::cerr << "Invalid face in OFF file: " << path << std::endl;
+        return false;
+    }
+
+    size_t indexCount = 0;
+    for (const auto& indices : chunkIndices) indexCount += indices.size();
+    mesh.indices.clear();
+    mesh.indices.reserve(indexCount);
+    for (const auto& indices : chunkIndices) mesh.indices.insert(mesh.indices.end(), indices.begin(), indices.end());
+
+    // Réduction des normales par tranches de sommets, puis normalisation
+    mesh.normals.assign(vertexCount, glm::vec3(0.0f));
+    size_t sliceSize = (vertexCount + chunkCount - 1) / chunkCount;
+    runParallel(chunkCount, [&](size_t slice) {
+        size_t sliceEnd = std::min(vertexCount, (slice + 1) * sliceSize);
+        for (size_t i = slice * sliceSize; i < sliceEnd; ++i) {
+            glm::vec3 normal(0.0f);
+            for (const auto& normals : chunkNormals) {
+                if (!normals.empty()) normal += normals[i];
+            }
+            float length = glm::length(normal);
+            mesh.normals[i] = (length > 0.0f) ? normal / length : glm::vec3(0.0f);
+        }
+    });
+
+    return true;
+}
+
+bool loadOBJ(const std::string& path, MeshData& mesh, unsigned threadCount) {
+    MappedFile file(path);
+    if (!file.isOpen()) return false;
+
+    unsigned chunkCount = resolveThreadCount(threadCount, file.getSize());
+    std::vector<const char*> bounds = splitAtLines(file.begin(), file.end(), chunkCount);
+
+    // Passe 1 : nombre de v / vt / vn par bloc, pour placer chaque élément et
+    // résoudre les indices négatifs sans attendre les blocs précédents
+    std::vector<OBJCounts> firstElement(chunkCount + 1);
+    runParallel(chunkCount, [&](size_t chunk) {
+        OBJCounts counts;
+        for (const char* line = bounds[chunk]; line < bounds[chunk + 1];) {
+            const char* eol = findLineEnd(line, bounds[chunk + 1]);
+            const char* p = line;
+            switch (classifyOBJLine(p, eol)) {
+                case OBJLine::Position: ++counts.positions; break;
+                case OBJLine::UV:       ++counts.uvs; break;
+                case OBJLine::Normal:   ++counts.normals; break;
+                default: break;
+            }
+            line = nextLine(eol, bounds[chunk + 1]);
+        }
+        firstElement[chunk + 1] = counts;
+    });
+    for (unsigned chunk = 0; chunk < chunkCount; ++chunk) {
+        firstElement[chunk + 1].positions += firstElement[chunk].positions;
+        firstElement[chunk + 1].uvs += firstElement[chunk].uvs;
+        firstElement[chunk + 1].normals += firstElement[chunk].normals;
+    }
+    const OBJCounts total = firstElement[chunkCount];
+    if (total.positions > OBJ_MAX_ELEMENTS || total.uvs > OBJ_MAX_ELEMENTS || total.normals > OBJ_MAX_ELEMENTS) {
+        std::cerr << "Too many elements in OBJ file: " << path << std::endl;
+        return false;
+    }
+
+    // Passe 2 : éléments écrits à leur place définitive, faces triangulées en coins empaquetés
+    std::vector<glm::vec3> positions(total.positions);
+    std::vector<glm::vec2> uvs(total.uvs);
+    std::vector<glm::vec3> normals(total.normals);
+    std::vector<std::vector<uint64_t>> chunkCorners(chunkCount);
+    std::vector<size_t> failedLine(chunkCount, 0);
+    runParallel(chunkCount, [&](size_t chunk) {
+        OBJCounts defined = firstElement[chunk];
+        std::vector<uint64_t>& corners = chunkCorners[chunk];
+        std::vector<uint64_t> polygon;
+        size_t lineNumber = 0;
+
+        for (const char* line = bounds[chunk]; line < bounds[chunk + 1];) {
+            const char* eol = findLineEnd(line, bounds[chunk + 1]);
+            const char* p = line;
+            ++lineNumber;
+            bool valid = true;
+
+            switch (classifyOBJLine(p, eol)) {
+                case OBJLine::Position: {
+                    glm::vec3& position = positions[defined.positions++];
+                    valid = parseNumber(p, eol, position.x) && parseNumber(p, eol, position.y) && parseNumber(p, eol, position.z);
+                    break;
+                }
+                case OBJLine::UV: {
+                    glm::vec2& uv = uvs[defined.uvs++];
+                    valid = parseNumber(p, eol, uv.x);
+                    if (valid && !parseNumber(p, eol, uv.y)) uv.y = 0.0f;
+                    break;
+                }
+                case OBJLine::Normal: {
+                    glm::vec3& normal = normals[defined.normals++];
+                    valid = parseNumber(p, eol, normal.x) && parseNumber(p, eol, normal.y) && parseNumber(p, eol, normal.z);
+                    break;
+                }
+                case OBJLine::Face: {
+                    polygon.clear();
+                    long index;
+                    while (valid && parseNumber(p, eol, index)) {
+                        uint32_t position, uv = 0, normal = 0;
+                        valid = resolveOBJIndex(index, defined.positions, total.positions, position);
+                        if (valid && p < eol && *p == '/') {
+                            ++p;
+                            if (p < eol && *p != '/') {
+                                valid = parseNumber(p, eol, index) && resolveOBJIndex(index, defined.uvs, total.uvs, uv);
+                                ++uv;
+                            }
+                            if (valid && p < eol && *p == '/') {
+                                ++p;
+                                valid = parseNumber(p, eol, index) && resolveOBJIndex(index, defined.normals, total.normals, normal);
+                                ++normal;
+                            }
+                        }
+                        polygon.push_back(packCorner(position + 1, uv, normal));
+                    }
+                    // Triangulation en éventail autour du premier sommet
+                    for (size_t k = 2; valid && k < polygon.size(); ++k) {
+                        corners.push_back(polygon[0]);
+                        corners.push_back(polygon[k - 1]);
+                        corners.push_back(polygon[k]);
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+
+            if (!valid) {
+                failedLine[chunk] = lineNumber;
+                return;
+            }
+            line = nextLine(eol, bounds[chunk + 1]);
+        }
+    });
+    for (unsigned chunk = 0; chunk < chunkCount; ++chunk) {
+        if (failedLine[chunk] != 0) {
+            std::cerr << "Invalid OBJ data in " << path << " (block " << chunk << ", line " << failedLine[chunk] << ")" << std::endl;
+            return false;
+        }
+    }
+
+    // Passe 3 : un sommet par triplet distinct
+    size_t cornerCount = 0;
+    for (const auto& corners : chunkCorners) cornerCount += corners.size();
+
+    std::unordered_map<uint64_t, unsigned short, CornerHash> uniqueCorners;
+    uniqueCorners.reserve(std::min(cornerCount, total.positions * 2 + 16));
+    std::vector<uint64_t> vertexKeys;
+    mesh.indices.clear();
+    mesh.indices.reserve(cornerCount);
+    for (const auto& corners : chunkCorners) {
+        for (uint64_t key : corners) {
+            auto inserted = uniqueCorners.emplace(key, static_cast<unsigned short>(vertexKeys.size()));
+            if (inserted.second) {
+                if (vertexKeys.size() > std::numeric_limits<unsigned short>::max()) {
+                    std::cerr << "Too many vertices for 16-bit indices: " << path << std::endl;
+                    return false;
+                }
+                vertexKeys.push_back(key);
+            }
+            mesh.indices.push_back(inserted.first->second);
+        }
+    }
+
+    const uint64_t indexMask = OBJ_MAX_ELEMENTS;
+    auto positionOf = [indexMask](uint64_t key) { return static_cast<size_t>(key & indexMask) - 1; };
+
+    // Normales lissées par position pour les coins qui n'en ont pas
+    std::vector<glm::vec3> smoothNormals;
+    bool needsSmoothNormals = false;
+    for (uint64_t key : vertexKeys) {
+        if ((key >> (2 * OBJ_INDEX_BITS)) == 0) {
+            needsSmoothNormals = true;
+            break;
+        }
+    }
+    if (needsSmoothNormals) {
+        smoothNormals.assign(total.positions, glm::vec3(0.0f));
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            size_t a = positionOf(vertexKeys[mesh.indices[i]]);
+            size_t b = positionOf(vertexKeys[mesh.indices[i + 1]]);
+            size_t c = positionOf(vertexKeys[mesh.indices[i + 2]]);
+            glm::vec3 faceNormal = glm::cross(positions[b] - positions[a], positions[c] - positions[a]);
+            float length = glm::length(faceNormal);
+            if (length > 0.0f) {
+                faceNormal /= length;
+                smoothNormals[a] += faceNormal;
+                smoothNormals[b] += faceNormal;
+                smoothNormals[c] += faceNormal;
+            }
+        }
+    }
+
+    mesh.vertices.resize(vertexKeys.size());
+    mesh.uvs.resize(vertexKeys.size());
+    mesh.normals.resize(vertexKeys.size());
+    for (size_t i = 0; i < vertexKeys.size(); ++i) {
+        uint64_t key = vertexKeys[i];
+        size_t position = positionOf(key);
+        size_t uv = static_cast<size_t>((key >> OBJ_INDEX_BITS) & indexMask);
+        size_t normal = static_cast<size_t>(key >> (2 * OBJ_INDEX_BITS));
+
+        mesh.vertices[i] = positions[position];
+        mesh.uvs[i] = uv ? uvs[uv - 1] : glm::vec2(0.0f);
+        glm::vec3 n = normal ? normals[normal - 1] : smoothNormals[position];
+        float length = glm::length(n);
+        mesh.normals[i] = (length > 0.0f) ? n / length : glm::vec3(0.0f);
+    }
+
+    return true;
+}
+
+} // namespace MeshLoader
@@ -0,0 +1,39 @@
+#ifndef MESH_LOADER_HPP__
+#define MESH_LOADER_HPP__
+
+#include <vector>
+#include <string>
+#include <glm/glm.hpp>
+
+// Données brutes d'un maillage, au format attendu par GameObject
+struct MeshData {
+    std::vector<glm::vec3> vertices;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec2> uvs;
+    std::vector<unsigned short> indices;
+
+    void clear() {
+        vertices.clear();
+        normals.clear();
+        uvs.clear();
+        indices.clear();
+    }
+};
+
+// Chargeurs de maillages : le fichier est projeté en mémoire puis découpé en
+// blocs alignés sur les fins de ligne, analysés en parallèle avec std::from_chars.
+namespace MeshLoader {
+
+    // OFF (et variantes NOFF, COFF...) : les faces polygonales sont triangulées en
+    // éventail et les normales de faces accumulées pendant la lecture des faces.
+    // threadCount = 0 : nombre de cœurs disponibles.
+    bool loadOFF(const std::string& path, MeshData& mesh, unsigned threadCount = 0);
+
+    // OBJ : faces "v", "v/vt", "v//vn" et "v/vt/vn", indices négatifs (relatifs) et
+    // polygones triangulés en éventail. Chaque triplet (position, uv, normale)
+    // distinct devient un sommet ; les normales absentes sont lissées par position.
+    bool loadOBJ(const std::string& path, MeshData& mesh, unsigned threadCount = 0);
+
+} // namespace MeshLoader
+
+#endif
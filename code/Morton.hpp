@@ -0,0 +1,68 @@
+#ifndef MORTON_HPP__
+#define MORTON_HPP__
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// Codes de Morton 3D (entrelacement des bits x, y, z) sur 21 bits par axe.
+// L'ordre des enfants d'un nœud correspond à celui de OctreeNode::subdivide :
+// bit 0 = x, bit 1 = y, bit 2 = z.
+namespace Morton {
+
+    // Écarte les 21 bits de poids faible de v : un bit utile tous les 3 bits
+    inline uint64_t splitBits(uint32_t v) {
+        uint64_t x = v & 0x1FFFFF;
+        x = (x | (x << 32)) & 0x1F00000000FFFFull;
+        x = (x | (x << 16)) & 0x1F0000FF0000FFull;
+        x = (x | (x << 8))  & 0x100F00F00F00F00Full;
+        x = (x | (x << 4))  & 0x10C30C30C30C30C3ull;
+        x = (x | (x << 2))  & 0x1249249249249249ull;
+        return x;
+    }
+
+    // Opération inverse de splitBits
+    inline uint32_t compactBits(uint64_t x) {
+        x &= 0x1249249249249249ull;
+        x = (x | (x >> 2))  & 0x10C30C30C30C30C3ull;
+        x = (x | (x >> 4))  & 0x100F00F00F00F00Full;
+        x = (x | (x >> 8))  & 0x1F0000FF0000FFull;
+        x = (x | (x >> 16)) & 0x1F00000000FFFFull;
+        x = (x | (x >> 32)) & 0x1FFFFFull;
+        return static_cast<uint32_t>(x);
+    }
+
+    inline uint64_t encode(uint32_t x, uint32_t y, uint32_t z) {
+        return splitBits(x) | (splitBits(y) << 1) | (splitBits(z) << 2);
+    }
+
+    inline glm::ivec3 decode(uint64_t code) {
+        return glm::ivec3(compactBits(code), compactBits(code >> 1), compactBits(code >> 2));
+    }
+
+    // Codes de localisation d'un octree linéaire : un bit sentinelle suivi du code
+    // de Morton du nœud (racine = 1, enfant i = (code << 3) | i)
+    const int MAX_LOCATIONAL_LEVEL = 21;
+
+    inline int locationalLevel(uint64_t code) {
+        int level = 0;
+        while (code > 1) {
+            code >>= 3;
+            ++level;
+        }
+        return level;
+    }
+
+    // Voisin de même niveau à travers la face donnée (0:-x 1:+x 2:-y 3:+y 4:-z 5:+z),
+    // 0 si le voisin sort de la racine
+    inline uint64_t faceNeighbourCode(uint64_t code, int face) {
+        int level = locationalLevel(code);
+        uint64_t sentinel = 1ull << (3 * level);
+        glm::ivec3 coords = decode(code ^ sentinel);
+        coords[face / 2] += (face & 1) ? 1 : -1;
+        if (coords[face / 2] < 0 || coords[face / 2] >= (1 << level)) return 0;
+        return encode(coords.x, coords.y, coords.z) | sentinel;
+    }
+
+} // namespace Morton
+
+#endif
@@ -12,6 +12,7 @@ RegularGrid::RegularGrid(const std::vector<unsigned short>& indices, const std::
 
 void RegularGrid::init(const std::vector<unsigned short>& indices, const std::vector<glm::vec3>& vertices, VoxelizationMethod method) {
     if (vertices.empty()) return;
+    this->method = method;
 
     glm::vec3 minVertex = vertices[0];
     glm::vec3 maxVertex = vertices[0];
@@ -26,6 +27,10 @@ void RegularGrid::init(const std::vector<unsigned short>& indices, const std::ve
 
     // Régénérer les sommets et indices
     generateVoxels();
+    if (voxels.empty()) {
+        std::cerr << "Erreur : grille trop grande pour la résolution " << resolution << "." << std::endl;
+        return;
+    }
 
     // Initialiser selon la méthode choisie
     switch (method) {
@@ -42,6 +47,7 @@ void RegularGrid::init(const std::vector<unsigned short>& indices, const std::ve
             voxelizeMeshSurface(indices, vertices);
             break;
     }
+    updateFaceMasks();
     selectedVoxel = &voxels[getVoxelIndex(0, 0, gridResolutionZ - 1)];
     selectedVoxel->isSelected = true;
     Grid::initializeBuffers();
@@ -55,9 +61,10 @@ void RegularGrid::generateVoxels() {
     float voxelSize = std::min({gridSize.x / resolution, gridSize.y / resolution, gridSize.z / resolution});
 
     // Calculer les résolutions de la grille, en ajoutant des voxels au bord
-    gridResolutionX = std::ceil(gridSize.x / voxelSize);  // +2 pour ajouter des voxels au bord
-    gridResolutionY = std::ceil(gridSize.y / voxelSize);  // +2 pour ajouter des voxels au bord
-    gridResolutionZ = std::ceil(gridSize.z / voxelSize);  // +2 pour ajouter des voxels au bord
+    glm::ivec3 resolutions = computeGridSize(minBounds, maxBounds, resolution);
+    gridResolutionX = resolutions.x;
+    gridResolutionY = resolutions.y;
+    gridResolutionZ = resolutions.z;
     
     float halfSize = voxelSize / 2;
     
@@ -80,6 +87,28 @@ void RegularGrid::generateVoxels() {
     std::cout << "Generated " << voxels.size() << " voxels.\n";
 }
 
+glm::ivec3 RegularGrid::computeGridSize(const glm::vec3& minBounds, const glm::vec3& maxBounds, int resolution) {
+    glm::vec3 gridSize = maxBounds - minBounds;
+    if (resolution <= 0 || !glm::all(glm::greaterThan(gridSize, glm::vec3(0.f)))) return glm::ivec3(0);
+
+    float voxelSize = std::min({gridSize.x / resolution, gridSize.y / resolution, gridSize.z / resolution});
+    glm::vec3 resolutions = glm::ceil(gridSize / voxelSize);
+    // Bornes infinies ou grille trop étirée pour un int
+    if (!glm::all(glm::lessThan(resolutions, glm::vec3(1 << 30)))) return glm::ivec3(0);
+    glm::ivec3 size(resolutions);
+    if (static_cast<uint64_t>(size.x) * size.y * size.z > MAX_VOXEL_COUNT) return glm::ivec3(0);
+    return size;
+}
+
+bool RegularGrid::canPackVoxels() const {
+    return !voxels.empty()
+        && voxels.size() == static_cast<size_t>(gridResolutionX) * gridResolutionY * gridResolutionZ;
+}
+
+float RegularGrid::getPackedVoxelSize() const {
+    return voxels.empty() ? 0.f : voxels[0].halfSize * 2.f;
+}
+
 VoxelData RegularGrid::getVoxel(int x, int y, int z) {
     // Calculer l'index unique dans la liste des voxels
     int index = x * gridResolutionY * gridResolutionZ + y * gridResolutionZ + z;
@@ -107,6 +136,57 @@ int RegularGrid::getColumnIndex(const VoxelData& voxel, int projectionAxis) cons
     return index1 * gridResolutionZ + index2;
 }
 
+OccupancyGrid RegularGrid::getOccupancy() const {
+    float voxelSize = voxels.empty() ? 0.0f : voxels[0].halfSize * 2;
+    OccupancyGrid occupancy(glm::ivec3(gridResolutionX, gridResolutionY, gridResolutionZ), minBounds, voxelSize);
+
+    // Les voxels sont déjà rangés dans l'ordre x * Y * Z + y * Z + z
+    for (size_t i = 0; i < voxels.size(); ++i) {
+        if (voxels[i].isEmpty == 0) occupancy.bits[i >> 6] |= 1ull << (i & 63);
+    }
+    return occupancy;
+}
+
+bool RegularGrid::restore(const glm::vec3& minBounds, const glm::vec3& maxBounds, int resolution,
+                          VoxelizationMethod method, const OccupancyGrid& occupancy, bool uploadBuffers) {
+    this->minBounds = minBounds;
+    this->maxBounds = maxBounds;
+    this->resolution = resolution;
+    this->method = method;
+
+    // Vérifié avant generateVoxels : des bornes ou une résolution corrompues ne doivent rien allouer
+    glm::ivec3 size = computeGridSize(minBounds, maxBounds, resolution);
+    if (size == glm::ivec3(0) || occupancy.size != size) {
+        std::cerr << "Erreur : dimensions de l'occupation incompatibles avec la grille ("
+                  << glm::to_string(occupancy.size) << ")." << std::endl;
+        voxels.clear();
+        return false;
+    }
+    generateVoxels();
+
+    // Même ordre x * Y * Z + y * Z + z que l'occupation, coins actifs comme après une voxelisation
+    activeCorner.clear();
+    for (size_t i = 0; i < voxels.size(); ++i) {
+        VoxelData& voxel = voxels[i];
+        voxel.isEmpty = ((occupancy.bits[i >> 6] >> (i & 63)) & 1) ? 0 : 1;
+        if (voxel.isEmpty) continue;
+        activeCorner.push_back(voxel.center + glm::vec3(-voxel.halfSize, -voxel.halfSize, -voxel.halfSize));
+        activeCorner.push_back(voxel.center + glm::vec3(voxel.halfSize, -voxel.halfSize, -voxel.halfSize));
+        activeCorner.push_back(voxel.center + glm::vec3(voxel.halfSize, -voxel.halfSize, voxel.halfSize));
+        activeCorner.push_back(voxel.center + glm::vec3(-voxel.halfSize, -voxel.halfSize, voxel.halfSize));
+        activeCorner.push_back(voxel.center + glm::vec3(-voxel.halfSize, voxel.halfSize, -voxel.halfSize));
+        activeCorner.push_back(voxel.center + glm::vec3(voxel.halfSize, voxel.halfSize, -voxel.halfSize));
+        activeCorner.push_back(voxel.center + glm::vec3(voxel.halfSize, voxel.halfSize, voxel.halfSize));
+        activeCorner.push_back(voxel.center + glm::vec3(-voxel.halfSize, voxel.halfSize, voxel.halfSize));
+    }
+
+    updateFaceMasks();
+    selectedVoxel = &voxels[getVoxelIndex(0, 0, gridResolutionZ - 1)];
+    selectedVoxel->isSelected = true;
+    if (uploadBuffers) Grid::initializeBuffers();
+    return true;
+}
+
 int RegularGrid::getVoxelIndex(int x, int y, int z) const {
     return x * gridResolutionY * gridResolutionZ + y * gridResolutionZ + z;
 }
@@ -133,6 +213,7 @@ glm::vec3 RegularGrid::getVoxelVec3Index(const VoxelData&voxel) const {
 }
 
 void RegularGrid::update(float deltaTime, GLFWwindow* window) {
+    VoxelData* previousSelection = selectedVoxel;
     if (glfwGetKey(window, GLFW_KEY_I) == GLFW_PRESS) {
         if (!keyYUpPressed) {
             keyYUpPressed = true;
@@ -216,6 +297,8 @@ void RegularGrid::update(float deltaTime, GLFWwindow* window) {
             keyAddPressed = true;
             glm::vec3 voxelVec3Idx = getVoxelVec3Index(*selectedVoxel);
             selectedVoxel->isEmpty = 0;
+            markVoxelDirty(*selectedVoxel);
+            updateFaceMasksAround(voxelVec3Idx.x, voxelVec3Idx.y, voxelVec3Idx.z);
             activeCorner.push_back(selectedVoxel->center + glm::vec3(-selectedVoxel->halfSize, -selectedVoxel->halfSize, -selectedVoxel->halfSize));
             activeCorner.push_back(selectedVoxel->center + glm::vec3(selectedVoxel->halfSize, -selectedVoxel->halfSize, -selectedVoxel->halfSize));
             activeCorner.push_back(selectedVoxel->center + glm::vec3(selectedVoxel->halfSize, -selectedVoxel->halfSize, selectedVoxel->halfSize));
@@ -234,6 +317,8 @@ void RegularGrid::update(float deltaTime, GLFWwindow* window) {
             keyDeletePressed = true;
             glm::vec3 voxelVec3Idx = getVoxelVec3Index(*selectedVoxel);
             selectedVoxel->isEmpty = 1;
+            markVoxelDirty(*selectedVoxel);
+            updateFaceMasksAround(voxelVec3Idx.x, voxelVec3Idx.y, voxelVec3Idx.z);
                         activeCorner.push_back(selectedVoxel->center + glm::vec3(-selectedVoxel->halfSize, -selectedVoxel->halfSize, -selectedVoxel->halfSize));
             activeCorner.erase(std::find(activeCorner.begin(), activeCorner.end(), selectedVoxel->center + glm::vec3(selectedVoxel->halfSize, -selectedVoxel->halfSize, -selectedVoxel->halfSize)));
             activeCorner.erase(std::find(activeCorner.begin(), activeCorner.end(), selectedVoxel->center + glm::vec3(selectedVoxel->halfSize, -selectedVoxel->halfSize, selectedVoxel->halfSize)));
@@ -247,7 +332,54 @@ void RegularGrid::update(float deltaTime, GLFWwindow* window) {
        }
     } else
         keyDeletePressed = false;
-    initializeBuffers();
+
+    // Seuls les voxels modifiés sont renvoyés au GPU, au prochain draw
+    if (selectedVoxel != previousSelection) {
+        markVoxelDirty(*previousSelection);
+        markVoxelDirty(*selectedVoxel);
+    }
+}
+
+int RegularGrid::computeFaceMask(int x, int y, int z) const {
+    // Une face est visible si le voisin de ce côté est vide ou hors de la grille
+    const glm::ivec3 size(gridResolutionX, gridResolutionY, gridResolutionZ);
+    const glm::ivec3 position(x, y, z);
+    int mask = 0;
+    for (int face = 0; face < 6; ++face) {
+        glm::ivec3 neighbour = position;
+        neighbour[face / 2] += (face & 1) ? 1 : -1;
+        if (neighbour[face / 2] < 0 || neighbour[face / 2] >= size[face / 2]
+            || voxels[getVoxelIndex(neighbour.x, neighbour.y, neighbour.z)].isEmpty) {
+            mask |= 1 << face;
+        }
+    }
+    return mask;
+}
+
+void RegularGrid::updateFaceMasks() {
+    for (int x = 0; x < gridResolutionX; ++x) {
+        for (int y = 0; y < gridResolutionY; ++y) {
+            for (int z = 0; z < gridResolutionZ; ++z) {
+                voxels[getVoxelIndex(x, y, z)].faceMask = computeFaceMask(x, y, z);
+            }
+        }
+    }
+}
+
+void RegularGrid::updateFaceMasksAround(int x, int y, int z) {
+    // Seuls le voxel et ses 6 voisins peuvent changer de masque
+    const glm::ivec3 offsets[7] = {{0, 0, 0}, {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}};
+    for (const glm::ivec3& offset : offsets) {
+        glm::ivec3 p = glm::ivec3(x, y, z) + offset;
+        if (p.x < 0 || p.y < 0 || p.z < 0 || p.x >= gridResolutionX || p.y >= gridResolutionY || p.z >= gridResolutionZ) continue;
+
+        VoxelData& voxel = voxels[getVoxelIndex(p.x, p.y, p.z)];
+        int mask = computeFaceMask(p.x, p.y, p.z);
+        if (mask != voxel.faceMask) {
+            voxel.faceMask = mask;
+            markVoxelDirty(voxel);
+        }
+    }
 }
 
 bool RegularGrid::intersectRayTriangle(const glm::vec3& rayOrigin, const glm::vec3& rayDir, 
@@ -541,12 +673,13 @@ void RegularGrid::printGrid() const {
         std::cout << std::endl; // Séparer les couches de voxels
     }
 }
-void RegularGrid::marchingCube( std::vector<unsigned short> &indices, std::vector<glm::vec3> &vertices) {
+void RegularGrid::marchingCube( std::vector<unsigned int> &indices, std::vector<glm::vec3> &vertices) {
     removeDuplicates(activeCorner);
 
     glm::vec3 gridSize = maxBounds - minBounds;
     float voxelSize = std::min({gridSize.x / resolution, gridSize.y / resolution, gridSize.z / resolution});
     float halfSize = voxelSize / 2;
+    std::vector<glm::vec3> triangles;
 
     // Parcours du volume de voxels
     for (int x = 0; x < gridResolutionX + 2; ++x) {
@@ -597,18 +730,16 @@ void RegularGrid::marchingCube( std::vector<unsigned short> &indices, std::vecto
                     int b2 = MarchingCubesTable::cornerIndexBFromEdge[triangulationData[k + 2]];
                     // addTriangle((corners[a] + corners[b]) * 0.5f, (corners[a1] + corners[b1]) * 0.5f, (corners[a2] + corners[b2]) * 0.5f, vertices, indices); 
 
-                    vertices.push_back((corners[a] + corners[b])*0.5f); 
-                    vertices.push_back((corners[a1] + corners[b1])*0.5f); 
-                    vertices.push_back((corners[a2] + corners[b2])*0.5f); 
-
-                    indices.push_back(vertices.size()-3);
-                    indices.push_back(vertices.size()-2);
-                    indices.push_back(vertices.size()-1);
-                   
+                    triangles.push_back((corners[a] + corners[b])*0.5f); 
+                    triangles.push_back((corners[a1] + corners[b1])*0.5f); 
+                    triangles.push_back((corners[a2] + corners[b2])*0.5f); 
                 }
             }
         }
     }
+
+    // Les sommets partagés entre cubes voisins sont fusionnés
+    weldTriangles(triangles, voxelSize * 1e-3f, indices, vertices);
 }
 
 
@@ -10,9 +10,9 @@
 
 class RegularGrid : public Grid {
 private:
-    int gridResolutionX;
-    int gridResolutionY;
-    int gridResolutionZ;
+    int gridResolutionX = 0;
+    int gridResolutionY = 0;
+    int gridResolutionZ = 0;
 
     std::vector<glm::vec3> vertices;
     std::vector<unsigned int> indices;
@@ -25,12 +25,24 @@ private:
     bool keyZDownPressed = false;
     bool keyAddPressed = false;
     bool keyDeletePressed = false;
+
+    int computeFaceMask(int x, int y, int z) const;
+
+    // Vertex pulling par blocs : coordonnées (x, y, z) retrouvées depuis l'indice x * Y * Z + y * Z + z
+    bool canPackVoxels() const override;
+    glm::ivec3 getGridSize() const override { return glm::ivec3(gridResolutionX, gridResolutionY, gridResolutionZ); }
+    float getPackedVoxelSize() const override;
 public:
+    static const size_t MAX_VOXEL_COUNT = (size_t(2) << 30) / sizeof(VoxelData); // Un VoxelData par cellule : 2 Go au plus
+
     RegularGrid() {};
     RegularGrid(const glm::vec3& minBounds, const glm::vec3& maxBounds, int resolution, VoxelizationMethod method);
     RegularGrid(const std::vector<unsigned short>& indices, const std::vector<glm::vec3>& vertices, int resolution, VoxelizationMethod method);
 
     void generateVoxels();       // Génère les voxels dans la grille
+    // Dimensions produites par generateVoxels pour ces bornes et cette résolution,
+    // (0, 0, 0) si elles sont invalides ou dépassent MAX_VOXEL_COUNT
+    static glm::ivec3 computeGridSize(const glm::vec3& minBounds, const glm::vec3& maxBounds, int resolution);
     void update(float deltaTime, GLFWwindow* window) override;
 
     VoxelData getVoxel(int x, int y, int z);
@@ -47,7 +59,17 @@ public:
     void voxelizeMesh(const std::vector<unsigned short>& indices, const std::vector<glm::vec3>& vertices);
     void voxelizeMeshSurface(const std::vector<unsigned short>& indices, const std::vector<glm::vec3>& vertices);
     void optimizedVoxelizeMesh(const std::vector<unsigned short>& indices, const std::vector<glm::vec3>& vertices);
-    void marchingCube( std::vector<unsigned short> &indices, std::vector<glm::vec3> &vertices) override;
+    void marchingCube( std::vector<unsigned int> &indices, std::vector<glm::vec3> &vertices) override;
+
+    // Faces cachées par un voisin plein, sur toute la grille ou autour d'un voxel ajouté / supprimé
+    void updateFaceMasks();
+    void updateFaceMasksAround(int x, int y, int z);
+
+    OccupancyGrid getOccupancy() const; // Occupation compactée, entrée de AdaptativeGrid(const OccupancyGrid&)
+    // Reconstruit la grille depuis une occupation enregistrée (VoxelGridFile), sans revoxeliser.
+    // Sans uploadBuffers, aucun appel OpenGL : initializeBuffers() reste à faire sur le thread de rendu
+    bool restore(const glm::vec3& minBounds, const glm::vec3& maxBounds, int resolution,
+                 VoxelizationMethod method, const OccupancyGrid& occupancy, bool uploadBuffers = true);
 
     virtual ~RegularGrid() = default;
 };
@@ -8,11 +8,35 @@ void SceneManager::addObject(std::unique_ptr<GameObject> object) {
 
 // Méthode pour mettre à jour tous les objets de la scène
 void SceneManager::update(float deltaTime, GLFWwindow* window) {
+    // Envoi des textures décodées depuis la dernière frame
+    TextureCache::instance().update();
+
     for (const auto& object : objects) {
         // Mettre à jour l'objet
         object->update(deltaTime);
-        if (object->isGridInitialized())
+        if (object->isGridInitialized()) {
             object->getGrid()->update(deltaTime, window);
+            // Blocs de voxels reconstruits sur le thread de travail, envoyés avant tout dessin
+            if (object->isShowVoxel()) object->getGrid()->updateChunks();
+        }
+    }
+}
+
+void SceneManager::cull(const Frustum& frustum) {
+    size_t culledBricks = cullingStats.culledBricks; // Compté par updateLOD
+    cullingStats = CullingStats();
+    cullingStats.culledBricks = culledBricks;
+
+    for (const auto& object : objects) {
+        object->cull(frustum);
+        if (object->isShowMesh()) {
+            ++cullingStats.objects;
+            if (!object->isInFrustum()) ++cullingStats.culledObjects;
+        }
+        if (object->isGridInitialized() && object->isShowVoxel()) {
+            ++cullingStats.grids;
+            if (!object->isVoxelInFrustum()) ++cullingStats.culledGrids;
+        }
     }
 }
 
@@ -20,18 +44,38 @@ void SceneManager::update(float deltaTime, GLFWwindow* window) {
 void SceneManager::draw(Shader &shader) {
     for (const auto& object : objects) {
         // Afficher l'objet
-        if(object->isShowMesh()) {
+        if(object->isShowMesh() && object->isInFrustum()) {
             object->draw(shader);
         }
 
     }
 }
 
-void SceneManager::drawVoxel(Shader &shader) {
+void SceneManager::drawBatched(Shader &shader) {
+    batchRenderer.draw(objects, shader);
+}
+
+void SceneManager::drawVoxel(Shader &shader, Shader &packedShader) {
+    const Shader *current = nullptr;
     for (const auto& object : objects) {
         
-        if(object->isShowVoxel()) {
-            object->drawVoxel(shader);
+        if(object->isShowVoxel() && object->isVoxelInFrustum()) {
+            Shader &objectShader = object->isGridInitialized() && object->getGrid()->usesPackedRendering() ? packedShader : shader;
+            if (current != &objectShader) {
+                objectShader.use();
+                current = &objectShader;
+            }
+            object->drawVoxel(objectShader);
+        }
+    }
+}
+
+void SceneManager::updateLOD(const glm::mat4& view, const glm::mat4& projection, float viewportHeight) {
+    cullingStats.culledBricks = 0;
+    for (const auto& object : objects) {
+        object->updateLOD(view, projection, viewportHeight);
+        if (object->isGridInitialized() && object->isShowVoxel()) {
+            cullingStats.culledBricks += object->getGrid()->getCulledBrickCount();
         }
     }
 }
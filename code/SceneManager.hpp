@@ -6,10 +6,22 @@
 #include "lib.hpp"
 #include "GameObject.hpp"
 #include "Mesh.hpp"
+#include "BatchRenderer.hpp"
+
+// Compteurs du culling de la dernière frame (onglet Rendu)
+struct CullingStats {
+    size_t objects = 0;         // Meshes affichables
+    size_t culledObjects = 0;   // ... hors du champ de la caméra
+    size_t grids = 0;           // Grilles de voxels affichables
+    size_t culledGrids = 0;
+    size_t culledBricks = 0;    // Nœuds d'octree écartés par le LOD, blocs VoxelChunks hors champ
+};
 
 class SceneManager {
 private:
     std::vector<std::unique_ptr<GameObject>> objects; // Vecteur de pointeurs uniques vers les objets de la scène ce qui garantit que chaque GameObject est géré par un unique SceneManager
+    BatchRenderer batchRenderer; // Rendu groupé des meshes (batch_vertex_shader.glsl)
+    CullingStats cullingStats;
 
 public:
     SceneManager() {}
@@ -21,8 +33,19 @@ public:
     void update(float deltaTime, GLFWwindow* window);
 
     // Méthode pour afficher tous les objets de la scène
+    // Marque les objets et grilles hors champ, à appeler avant draw et drawVoxel
+    void cull(const Frustum& frustum);
+    const CullingStats& getCullingStats() const { return cullingStats; }
+
     void draw(Shader &shader);
-    void drawVoxel(Shader &shader);
+    // Tous les meshes en quelques appels, avec le shader batch_*_shader.glsl
+    void drawBatched(Shader &shader);
+    const BatchRenderer& getBatchRenderer() const { return batchRenderer; }
+    // packedShader : grilles rendues par vertex pulling (Grid::usesPackedRendering)
+    void drawVoxel(Shader &shader, Shader &packedShader);
+
+    // Méthode pour mettre à jour le niveau de détail des grilles selon la caméra
+    void updateLOD(const glm::mat4& view, const glm::mat4& projection, float viewportHeight);
 
     void initGameObjectsTexture();
     GameObject *getObjectByName(const std::string& name);
@@ -0,0 +1,280 @@
+#include "SceneSnapshot.hpp"
+#include "VoxelGridFile.hpp"
+#include "MappedFile.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace {
+    const char SNAPSHOT_MAGIC[4] = {'S', 'C', 'N', 'S'};
+    const uint32_t SNAPSHOT_VERSION = 1;
+
+    enum ObjectFlags : uint8_t {
+        SHOW_MESH = 1 << 0,
+        SHOW_VOXEL = 1 << 1,
+        WIREFRAME = 1 << 2,
+        WIREFRAME_VOXEL = 1 << 3
+    };
+
+    struct ObjectRecord {
+        std::string name, meshPath, texturePath, gridPath;
+        glm::vec4 color;
+        glm::vec3 position, rotation, scale;
+        glm::vec3 initialPosition, initialRotation, initialScale;
+        glm::vec3 ambient, diffuse, specular;
+        double shininess;
+        glm::vec3 gridColor;
+        int32_t gridType, voxelResolution;
+        uint8_t flags;
+    };
+
+    class SnapshotWriter {
+    private:
+        std::vector<char> buffer;
+    public:
+        template <typename T>
+        void write(const T& value) {
+            const char* bytes = reinterpret_cast<const char*>(&value);
+            buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+        }
+        void writeString(const std::string& value) {
+            write(static_cast<uint32_t>(value.size()));
+            buffer.insert(buffer.end(), value.begin(), value.end());
+        }
+        const std::vector<char>& getBuffer() const { return buffer; }
+    };
+
+    // Lecture bornée dans la projection : toute lecture hors fichier invalide le lecteur
+    class SnapshotReader {
+    private:
+        const char* cursor;
+        const char* end;
+        bool valid = true;
+    public:
+        SnapshotReader(const char* begin, const char* end) : cursor(begin), end(end) {}
+
+        template <typename T>
+        T read() {
+            T value {};
+            if (!valid || static_cast<size_t>(end - cursor) < sizeof(T)) {
+                valid = false;
+                return value;
+            }
+            std::memcpy(&value, cursor, sizeof(T));
+            cursor += sizeof(T);
+            return value;
+        }
+        std::string readString() {
+            uint32_t size = read<uint32_t>();
+            if (!valid || static_cast<size_t>(end - cursor) < size) {
+                valid = false;
+                return std::string();
+            }
+            std::string value(cursor, size);
+            cursor += size;
+            return value;
+        }
+        bool isValid() const { return valid; }
+    };
+
+    void writeRecord(SnapshotWriter& writer, const ObjectRecord& record) {
+        writer.writeString(record.name);
+        writer.writeString(record.meshPath);
+        writer.writeString(record.texturePath);
+        writer.writeString(record.gridPath);
+        writer.write(record.color);
+        writer.write(record.position);
+        writer.write(record.rotation);
+        writer.write(record.scale);
+        writer.write(record.initialPosition);
+        writer.write(record.initialRotation);
+        writer.write(record.initialScale);
+        writer.write(record.ambient);
+        writer.write(record.diffuse);
+        writer.write(record.specular);
+        writer.write(record.shininess);
+        writer.write(record.gridColor);
+        writer.write(record.gridType);
+        writer.write(record.voxelResolution);
+        writer.write(record.flags);
+    }
+
+    ObjectRecord readRecord(SnapshotReader& reader) {
+        ObjectRecord record;
+        record.name = reader.readString();
+        record.meshPath = reader.readString();
+        record.texturePath = reader.readString();
+        record.gridPath = reader.readString();
+        record.color = reader.read<glm::vec4>();
+        record.position = reader.read<glm::vec3>();
+        record.rotation = reader.read<glm::vec3>();
+        record.scale = reader.read<glm::vec3>();
+        record.initialPosition = reader.read<glm::vec3>();
+        record.initialRotation = reader.read<glm::vec3>();
+        record.initialScale = reader.read<glm::vec3>();
+        record.ambient = reader.read<glm::vec3>();
+        record.diffuse = reader.read<glm::vec3>();
+        record.specular = reader.read<glm::vec3>();
+        record.shininess = reader.read<double>();
+        record.gridColor = reader.read<glm::vec3>();
+        record.gridType = reader.read<int32_t>();
+        record.voxelResolution = reader.read<int32_t>();
+        record.flags = reader.read<uint8_t>();
+        return record;
+    }
+}
+
+bool SceneSnapshot::save(const std::string& filename, SceneManager& scene) {
+    SnapshotWriter writer;
+    uint32_t objectCount = 0;
+
+    for (auto& object : scene.getObjects()) {
+        Mesh* mesh = dynamic_cast<Mesh*>(object.get());
+        if (mesh == nullptr || mesh->getMeshPath().empty()) continue;
+
+        ObjectRecord record;
+        record.name = mesh->getName();
+        record.meshPath = mesh->getMeshPath();
+        record.texturePath = mesh->getTexturePath();
+        record.color = mesh->getColor();
+
+        const Transform& transform = mesh->getTransform();
+        record.position = transform.getPosition();
+        record.rotation = transform.getRotation();
+        record.scale = transform.getScale();
+        const Transform& initialTransform = mesh->getInitialTransform();
+        record.initialPosition = initialTransform.getPosition();
+        record.initialRotation = initialTransform.getRotation();
+        record.initialScale = initialTransform.getScale();
+
+        const Material& material = mesh->getMaterial();
+        record.ambient = material.getAmbient();
+        record.diffuse = material.getDiffuse();
+        record.specular = material.getSpecular();
+        record.shininess = material.getShininess();
+
+        record.gridType = static_cast<int32_t>(mesh->getGridType());
+        record.voxelResolution = mesh->getVoxelResolution();
+        record.gridColor = glm::vec3(1.0f);
+        record.flags = (mesh->isShowMesh() ? SHOW_MESH : 0) | (mesh->isShowVoxel() ? SHOW_VOXEL : 0)
+                     | (mesh->getIsWireframe() ? WIREFRAME : 0) | (mesh->getIsWireframeVoxel() ? WIREFRAME_VOXEL : 0);
+
+        // La grille est enregistrée à part, au format .vxg
+        if (mesh->isGridInitialized() && mesh->getGrid() != nullptr) {
+            record.gridPath = filename + "." + std::to_string(objectCount) + ".vxg";
+            record.gridColor = mesh->getGrid()->getColor();
+            if (!VoxelGridFile::save(record.gridPath, *mesh->getGrid())) record.gridPath.clear();
+        }
+
+        writeRecord(writer, record);
+        ++objectCount;
+    }
+
+    std::ofstream outFile(filename, std::ios::binary);
+    if (!outFile) {
+        std::cerr << "Erreur : impossible d'ouvrir le fichier pour écrire la scène." << std::endl;
+        return false;
+    }
+    outFile.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    outFile.write(reinterpret_cast<const char*>(&SNAPSHOT_VERSION), sizeof(SNAPSHOT_VERSION));
+    outFile.write(reinterpret_cast<const char*>(&objectCount), sizeof(objectCount));
+    outFile.write(writer.getBuffer().data(), writer.getBuffer().size());
+    if (!outFile) {
+        std::cerr << "Erreur : écriture incomplète de " << filename << std::endl;
+        return false;
+    }
+
+    std::cout << "Scène enregistrée : " << filename << " (" << objectCount << " objets)" << std::endl;
+    return true;
+}
+
+bool SceneSnapshot::load(const std::string& filename, SceneManager& scene, Shader& shader, unsigned threadCount) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<ObjectRecord> records;
+    {
+        MappedFile file(filename);
+        if (!file.isOpen()) return false;
+
+        SnapshotReader reader(file.begin(), file.end());
+        char magic[4];
+        for (char& c : magic) c = reader.read<char>();
+        uint32_t version = reader.read<uint32_t>();
+        uint32_t objectCount = reader.read<uint32_t>();
+        if (!reader.isValid() || !std::equal(magic, magic + 4, SNAPSHOT_MAGIC) || version != SNAPSHOT_VERSION) {
+            std::cerr << "Erreur : " << filename << " n'est pas un instantané de scène valide." << std::endl;
+            return false;
+        }
+
+        for (uint32_t i = 0; i < objectCount && reader.isValid(); ++i) {
+            records.push_back(readRecord(reader));
+        }
+        if (!reader.isValid()) {
+            std::cerr << "Erreur : instantané de scène tronqué : " << filename << std::endl;
+            return false;
+        }
+    }
+
+    // Caches de maillage et grilles lus en parallèle, sans appel OpenGL
+    std::vector<std::unique_ptr<MeshData>> meshes(records.size());
+    std::vector<std::unique_ptr<Grid>> grids(records.size());
+    std::atomic<size_t> nextRecord {0};
+    auto worker = [&]() {
+        for (size_t i = nextRecord++; i < records.size(); i = nextRecord++) {
+            std::unique_ptr<MeshData> data(new MeshData());
+            if (Mesh::loadMeshData(records[i].meshPath, *data)) meshes[i] = std::move(data);
+            if (!records[i].gridPath.empty()) grids[i] = VoxelGridFile::load(records[i].gridPath, false);
+        }
+    };
+
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::min<unsigned>(threadCount, std::max<size_t>(records.size(), 1));
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < threadCount; ++t) threads.emplace_back(worker);
+    worker();
+    for (std::thread& thread : threads) thread.join();
+
+    // Envois GPU et création des objets sur le thread de rendu (textures décodées en arrière-plan)
+    size_t restored = 0;
+    glActiveTexture(GL_TEXTURE0);
+    for (size_t i = 0; i < records.size(); ++i) {
+        const ObjectRecord& record = records[i];
+        if (!meshes[i]) {
+            std::cerr << "Objet " << record.name << " ignoré : maillage introuvable (" << record.meshPath << ")" << std::endl;
+            continue;
+        }
+
+        GLuint textureID = record.texturePath.empty() ? 0 : TextureCache::instance().acquireAsync(record.texturePath);
+        Mesh* mesh = new Mesh(record.name, textureID, record.texturePath.c_str(), shader);
+        mesh->setCachedTexture(textureID);
+        mesh->setMeshData(*meshes[i], record.meshPath);
+        mesh->setMaterial(Material(record.ambient, record.diffuse, record.specular, record.shininess));
+        mesh->setColor(record.color);
+        mesh->setTransform(Transform(record.position, record.rotation, record.scale));
+        mesh->setInitalTransform(Transform(record.initialPosition, record.initialRotation, record.initialScale));
+        mesh->setGridType(static_cast<GridType>(record.gridType));
+        mesh->setVoxelResolution(record.voxelResolution);
+        mesh->isShowMesh() = (record.flags & SHOW_MESH) != 0;
+        mesh->getIsWireframe() = (record.flags & WIREFRAME) != 0;
+        mesh->getIsWireframeVoxel() = (record.flags & WIREFRAME_VOXEL) != 0;
+
+        if (grids[i]) {
+            grids[i]->initializeBuffers();
+            grids[i]->setColor(record.gridColor);
+            mesh->setGrid(std::move(grids[i]));
+            mesh->setGridInitialized(true);
+            mesh->setShowVoxel((record.flags & SHOW_VOXEL) != 0);
+        }
+
+        scene.addObject(std::move(mesh->ptr));
+        ++restored;
+    }
+    shader.setInt("gameObjectTexture", 0);
+
+    float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Scène restaurée : " << restored << " / " << records.size() << " objets en " << elapsed << " ms" << std::endl;
+    return restored > 0;
+}
@@ -0,0 +1,19 @@
+#ifndef SCENE_SNAPSHOT_HPP__
+#define SCENE_SNAPSHOT_HPP__
+
+#include <string>
+#include "SceneManager.hpp"
+
+// Instantané binaire de la scène : pour chaque Mesh, le chemin de la source
+// (relue via son cache .meshcache), la texture, les transformations, le matériau,
+// les options d'affichage et, si elle existe, la grille enregistrée à côté
+// (<fichier>.<indice>.vxg). La restauration lit caches et grilles en parallèle,
+// seuls les envois GPU restent sur le thread de rendu.
+class SceneSnapshot {
+public:
+    static bool save(const std::string& filename, SceneManager& scene);
+    // Ajoute les objets de l'instantané à la scène, false si rien n'a été restauré
+    static bool load(const std::string& filename, SceneManager& scene, Shader& shader, unsigned threadCount = 0);
+};
+
+#endif
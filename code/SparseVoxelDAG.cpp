@@ -0,0 +1,323 @@
+#include "SparseVoxelDAG.hpp"
+#include "AdaptativeGrid.hpp"
+#include <fstream>
+#include <iostream>
+
+namespace {
+    const char DAG_MAGIC[4] = {'S', 'V', 'D', 'G'};
+    const uint32_t DAG_VERSION = 1;
+
+    int countBits(uint32_t v) {
+        v = v - ((v >> 1) & 0x55555555u);
+        v = (v & 0x33333333u) + ((v >> 2) & 0x33333333u);
+        return (((v + (v >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+    }
+
+    // Hachage FNV-1a sur les mots d'un nœud encodé
+    uint64_t hashWords(const uint32_t* words, size_t count) {
+        uint64_t h = 1469598103934665603ull;
+        for (size_t i = 0; i < count; ++i) {
+            h ^= words[i];
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    // Test rayon / boîte (méthode des slabs), renvoie l'intervalle [t0, t1]
+    bool intersectBox(const glm::vec3& origin, const glm::vec3& invDir,
+                      const glm::vec3& boxMin, const glm::vec3& boxMax, float& t0, float& t1) {
+        glm::vec3 tA = (boxMin - origin) * invDir;
+        glm::vec3 tB = (boxMax - origin) * invDir;
+        glm::vec3 tNear = glm::min(tA, tB);
+        glm::vec3 tFar = glm::max(tA, tB);
+        t0 = glm::max(glm::max(tNear.x, tNear.y), tNear.z);
+        t1 = glm::min(glm::min(tFar.x, tFar.y), tFar.z);
+        return t1 >= glm::max(t0, 0.0f);
+    }
+
+    glm::vec3 childOffset(int child) {
+        return glm::vec3((child & 1) ? 1.0f : 0.0f, (child & 2) ? 1.0f : 0.0f, (child & 4) ? 1.0f : 0.0f);
+    }
+}
+
+SparseVoxelDAG::SparseVoxelDAG(const OctreeNode& root, const glm::vec3& minBounds, const glm::vec3& maxBounds)
+    : minBounds(minBounds), maxBounds(maxBounds)
+{
+    sourceNodeCount = 1;
+    if (root.isLeaf) {
+        rootIndex = FULL_ROOT;
+        return;
+    }
+    if (root.children.empty()) {
+        rootIndex = EMPTY_ROOT;
+        return;
+    }
+
+    std::unordered_multimap<uint64_t, uint32_t> uniqueNodes;
+    rootIndex = buildNode(root, 0, uniqueNodes);
+    nodes.shrink_to_fit();
+}
+
+uint32_t SparseVoxelDAG::buildNode(const OctreeNode& node, int level,
+                                   std::unordered_multimap<uint64_t, uint32_t>& uniqueNodes) {
+    depth = std::max(depth, level + 1);
+
+    // Construction ascendante : les enfants sont encodés avant le parent
+    uint32_t childMask = 0, fullMask = 0;
+    uint32_t words[9];
+    int wordCount = 1;
+    for (size_t i = 0; i < node.children.size() && i < 8; ++i) {
+        const OctreeNode& child = node.children[i];
+        ++sourceNodeCount;
+
+        uint32_t childIndex;
+        if (child.isLeaf) {
+            childIndex = FULL_ROOT;
+        } else if (child.children.empty()) {
+            childIndex = EMPTY_ROOT;
+        } else {
+            childIndex = buildNode(child, level + 1, uniqueNodes);
+        }
+
+        if (childIndex == EMPTY_ROOT) continue;
+        childMask |= 1u << i;
+        if (childIndex == FULL_ROOT) {
+            fullMask |= 1u << i;
+        } else {
+            words[wordCount++] = childIndex;
+        }
+    }
+
+    // Sous-arbres homogènes : pas de nœud à stocker
+    if (childMask == 0) return EMPTY_ROOT;
+    if (fullMask == 0xFF) return FULL_ROOT;
+
+    words[0] = childMask | (fullMask << 8);
+
+    // Déduplication : un nœud identique a déjà été émis ?
+    uint64_t h = hashWords(words, wordCount);
+    auto range = uniqueNodes.equal_range(h);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (std::equal(words, words + wordCount, nodes.begin() + it->second)) {
+            return it->second;
+        }
+    }
+
+    uint32_t index = static_cast<uint32_t>(nodes.size());
+    nodes.insert(nodes.end(), words, words + wordCount);
+    uniqueNodes.emplace(h, index);
+    return index;
+}
+
+bool SparseVoxelDAG::isOccupied(const glm::vec3& point) const {
+    if (rootIndex == EMPTY_ROOT) return false;
+
+    glm::vec3 extent = glm::max(maxBounds - minBounds, glm::vec3(LITTLE_EPSILON));
+    glm::vec3 p = (point - minBounds) / extent;
+    if (glm::any(glm::lessThan(p, glm::vec3(0.0f))) || glm::any(glm::greaterThan(p, glm::vec3(1.0f)))) return false;
+    if (rootIndex == FULL_ROOT) return true;
+
+    uint32_t index = rootIndex;
+    for (int level = 0; level < MAX_DEPTH; ++level) {
+        uint32_t header = nodes[index];
+        uint32_t childMask = header & 0xFF;
+        uint32_t fullMask = (header >> 8) & 0xFF;
+
+        int child = (p.x >= 0.5f ? 1 : 0) | (p.y >= 0.5f ? 2 : 0) | (p.z >= 0.5f ? 4 : 0);
+        p = p * 2.0f - childOffset(child);
+
+        uint32_t bit = 1u << child;
+        if (!(childMask & bit)) return false;
+        if (fullMask & bit) return true;
+
+        // Les pointeurs ne sont stockés que pour les enfants partiels
+        uint32_t pointerMask = childMask & ~fullMask;
+        index = nodes[index + 1 + countBits(pointerMask & (bit - 1))];
+    }
+    return false;
+}
+
+bool SparseVoxelDAG::raycast(const glm::vec3& origin, const glm::vec3& direction, float& tHit) const {
+    if (rootIndex == EMPTY_ROOT) return false;
+
+    // Parcours dans l'espace normalisé [0,1]^3 : le paramètre t est conservé
+    glm::vec3 extent = glm::max(maxBounds - minBounds, glm::vec3(LITTLE_EPSILON));
+    glm::vec3 o = (origin - minBounds) / extent;
+    glm::vec3 d = direction / extent;
+    // Évite les 0 * inf (NaN) lorsque l'origine est sur un plan de séparation
+    for (int axis = 0; axis < 3; ++axis) {
+        if (std::abs(d[axis]) < LITTLE_EPSILON) d[axis] = (d[axis] < 0.0f) ? -LITTLE_EPSILON : LITTLE_EPSILON;
+    }
+    glm::vec3 invDir = 1.0f / d;
+
+    float t0, t1;
+    if (!intersectBox(o, invDir, glm::vec3(0.0f), glm::vec3(1.0f), t0, t1)) return false;
+    if (rootIndex == FULL_ROOT) {
+        tHit = glm::max(t0, 0.0f);
+        return true;
+    }
+
+    struct StackEntry {
+        uint32_t index;     // FULL_ROOT pour une cellule pleine
+        glm::vec3 cellMin;
+        float cellSize;
+        float tEnter;
+    };
+    StackEntry stack[8 * MAX_DEPTH + 1];
+    int stackSize = 0;
+    stack[stackSize++] = {rootIndex, glm::vec3(0.0f), 1.0f, glm::max(t0, 0.0f)};
+
+    while (stackSize > 0) {
+        StackEntry entry = stack[--stackSize];
+        if (entry.index == FULL_ROOT) {
+            tHit = entry.tEnter;
+            return true;
+        }
+
+        uint32_t header = nodes[entry.index];
+        uint32_t childMask = header & 0xFF;
+        uint32_t fullMask = (header >> 8) & 0xFF;
+        uint32_t pointerMask = childMask & ~fullMask;
+        float halfSize = entry.cellSize * 0.5f;
+
+        // Enfants traversés, triés d'avant en arrière
+        StackEntry hits[8];
+        int hitCount = 0;
+        for (int child = 0; child < 8; ++child) {
+            uint32_t bit = 1u << child;
+            if (!(childMask & bit)) continue;
+
+            glm::vec3 childMin = entry.cellMin + childOffset(child) * halfSize;
+            if (!intersectBox(o, invDir, childMin, childMin + glm::vec3(halfSize), t0, t1)) continue;
+
+            uint32_t childIndex = (fullMask & bit) ? FULL_ROOT
+                                : nodes[entry.index + 1 + countBits(pointerMask & (bit - 1))];
+            StackEntry hit = {childIndex, childMin, halfSize, glm::max(t0, 0.0f)};
+
+            int k = hitCount++;
+            while (k > 0 && hits[k - 1].tEnter > hit.tEnter) {
+                hits[k] = hits[k - 1];
+                --k;
+            }
+            hits[k] = hit;
+        }
+
+        // Empiler en ordre inverse pour dépiler le plus proche en premier
+        for (int k = hitCount - 1; k >= 0; --k) {
+            stack[stackSize++] = hits[k];
+        }
+    }
+    return false;
+}
+
+bool SparseVoxelDAG::save(const std::string& filename) const {
+    std::ofstream outFile(filename, std::ios::binary);
+    if (!outFile) {
+        std::cerr << "Erreur : impossible d'ouvrir le fichier pour écrire le DAG." << std::endl;
+        return false;
+    }
+
+    uint64_t sourceCount = sourceNodeCount;
+    uint64_t wordCount = nodes.size();
+    int32_t fileDepth = depth;
+    outFile.write(DAG_MAGIC, sizeof(DAG_MAGIC));
+    outFile.write(reinterpret_cast<const char*>(&DAG_VERSION), sizeof(DAG_VERSION));
+    outFile.write(reinterpret_cast<const char*>(&minBounds[0]), sizeof(glm::vec3));
+    outFile.write(reinterpret_cast<const char*>(&maxBounds[0]), sizeof(glm::vec3));
+    outFile.write(reinterpret_cast<const char*>(&fileDepth), sizeof(fileDepth));
+    outFile.write(reinterpret_cast<const char*>(&rootIndex), sizeof(rootIndex));
+    outFile.write(reinterpret_cast<const char*>(&sourceCount), sizeof(sourceCount));
+    outFile.write(reinterpret_cast<const char*>(&wordCount), sizeof(wordCount));
+    outFile.write(reinterpret_cast<const char*>(nodes.data()), wordCount * sizeof(uint32_t));
+
+    std::cout << "DAG exporté : " << filename << " (" << getSizeInBytes() << " octets)" << std::endl;
+    return static_cast<bool>(outFile);
+}
+
+// Vérifie un tableau de nœuds lu depuis un fichier. Les enfants étant encodés avant leur
+// parent (construction ascendante), tout pointeur doit viser le début d'un nœud situé
+// strictement avant : le graphe est alors acyclique et sa hauteur se calcule en un passage.
+bool SparseVoxelDAG::validateNodes(const std::vector<uint32_t>& words, uint32_t root, int maxDepth) {
+    // Hauteur de chaque nœud, 0 pour un mot qui n'est pas un en-tête
+    std::vector<uint8_t> height(words.size(), 0);
+    size_t index = 0;
+    while (index < words.size()) {
+        uint32_t header = words[index];
+        uint32_t childMask = header & 0xFF;
+        uint32_t fullMask = (header >> 8) & 0xFF;
+        if ((header >> 16) != 0 || childMask == 0 || (fullMask & ~childMask) != 0) return false;
+
+        int pointerCount = countBits(childMask & ~fullMask);
+        if (index + 1 + pointerCount > words.size()) return false;
+
+        int nodeHeight = 1;
+        for (int i = 1; i <= pointerCount; ++i) {
+            uint32_t child = words[index + i];
+            if (child >= index || height[child] == 0) return false;
+            nodeHeight = std::max(nodeHeight, height[child] + 1);
+        }
+        if (nodeHeight > maxDepth) return false;
+        height[index] = static_cast<uint8_t>(nodeHeight);
+        index += 1 + pointerCount;
+    }
+    if (root == EMPTY_ROOT || root == FULL_ROOT) return true;
+    return root < words.size() && height[root] != 0;
+}
+
+bool SparseVoxelDAG::load(const std::string& filename) {
+    std::ifstream inFile(filename, std::ios::binary);
+    if (!inFile) {
+        std::cerr << "Erreur : impossible d'ouvrir le fichier DAG " << filename << std::endl;
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version;
+    inFile.read(magic, sizeof(magic));
+    inFile.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (!inFile || !std::equal(magic, magic + 4, DAG_MAGIC) || version != DAG_VERSION) {
+        std::cerr << "Erreur : " << filename << " n'est pas un fichier DAG valide." << std::endl;
+        return false;
+    }
+
+    // En-tête lu dans des variables locales : l'état courant n'est remplacé qu'après validation
+    glm::vec3 fileMin, fileMax;
+    int32_t fileDepth;
+    uint32_t fileRoot;
+    uint64_t sourceCount, wordCount;
+    inFile.read(reinterpret_cast<char*>(&fileMin[0]), sizeof(glm::vec3));
+    inFile.read(reinterpret_cast<char*>(&fileMax[0]), sizeof(glm::vec3));
+    inFile.read(reinterpret_cast<char*>(&fileDepth), sizeof(fileDepth));
+    inFile.read(reinterpret_cast<char*>(&fileRoot), sizeof(fileRoot));
+    inFile.read(reinterpret_cast<char*>(&sourceCount), sizeof(sourceCount));
+    inFile.read(reinterpret_cast<char*>(&wordCount), sizeof(wordCount));
+    if (!inFile || fileDepth < 0 || fileDepth > MAX_DEPTH) {
+        std::cerr << "Erreur : en-tête DAG invalide dans " << filename << std::endl;
+        return false;
+    }
+
+    // Taille annoncée confrontée à la taille réelle avant toute allocation
+    std::streamoff headerEnd = inFile.tellg();
+    inFile.seekg(0, std::ios::end);
+    std::streamoff remaining = inFile.tellg() - headerEnd;
+    inFile.seekg(headerEnd);
+    if (remaining < 0 || wordCount > static_cast<uint64_t>(remaining) / sizeof(uint32_t)) {
+        std::cerr << "Erreur : DAG tronqué dans " << filename << std::endl;
+        return false;
+    }
+
+    std::vector<uint32_t> words(static_cast<size_t>(wordCount));
+    inFile.read(reinterpret_cast<char*>(words.data()), wordCount * sizeof(uint32_t));
+    if (!inFile || !validateNodes(words, fileRoot, fileDepth)) {
+        std::cerr << "Erreur : DAG corrompu dans " << filename << std::endl;
+        return false;
+    }
+
+    minBounds = fileMin;
+    maxBounds = fileMax;
+    depth = fileDepth;
+    rootIndex = fileRoot;
+    nodes = std::move(words);
+    sourceNodeCount = sourceCount;
+    return true;
+}
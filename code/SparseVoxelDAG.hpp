@@ -0,0 +1,55 @@
+#ifndef SPARSE_VOXEL_DAG_HPP__
+#define SPARSE_VOXEL_DAG_HPP__
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+#include <glm/glm.hpp>
+
+struct OctreeNode;
+
+// Graphe orienté acyclique de voxels (SVDAG) construit à partir d'un octree.
+// Chaque nœud est encodé dans `nodes` par un mot d'en-tête suivi d'un pointeur
+// par enfant non vide et non plein :
+//   bits 0-7  : masque des enfants non vides
+//   bits 8-15 : masque des enfants entièrement pleins (aucun pointeur stocké)
+// Les sous-arbres identiques sont fusionnés lors de la construction.
+class SparseVoxelDAG {
+private:
+    static const uint32_t EMPTY_ROOT = 0xFFFFFFFFu;
+    static const uint32_t FULL_ROOT = 0xFFFFFFFEu;
+    static const int MAX_DEPTH = 32;
+
+    glm::vec3 minBounds {0.f};
+    glm::vec3 maxBounds {0.f};
+    int depth = 0;                  // Profondeur maximale de l'octree source
+    uint32_t rootIndex = EMPTY_ROOT;
+    std::vector<uint32_t> nodes;    // Nœuds encodés (en-tête + pointeurs enfants)
+    size_t sourceNodeCount = 0;     // Nombre de nœuds de l'octree d'origine
+
+    uint32_t buildNode(const OctreeNode& node, int level,
+                       std::unordered_multimap<uint64_t, uint32_t>& uniqueNodes);
+    static bool validateNodes(const std::vector<uint32_t>& words, uint32_t root, int maxDepth);
+
+public:
+    SparseVoxelDAG() {}
+    SparseVoxelDAG(const OctreeNode& root, const glm::vec3& minBounds, const glm::vec3& maxBounds);
+
+    // Requêtes exécutées directement sur la forme compressée
+    bool isOccupied(const glm::vec3& point) const;
+    bool raycast(const glm::vec3& origin, const glm::vec3& direction, float& tHit) const;
+
+    bool save(const std::string& filename) const;
+    bool load(const std::string& filename);
+
+    const glm::vec3& getMinBounds() const { return minBounds; }
+    const glm::vec3& getMaxBounds() const { return maxBounds; }
+    int getDepth() const { return depth; }
+    bool isEmpty() const { return rootIndex == EMPTY_ROOT; }
+    size_t getSourceNodeCount() const { return sourceNodeCount; }
+    size_t getNodeWordCount() const { return nodes.size(); }
+    size_t getSizeInBytes() const { return nodes.size() * sizeof(uint32_t); }
+};
+
+#endif
@@ -0,0 +1,133 @@
+#include "TextureCache.hpp"
+#include "stb_image.hpp"
+#include <filesystem>
+#include <algorithm>
+#include <iostream>
+
+TextureCache::DecodedImage::~DecodedImage() {
+    if (pixels) stbi_image_free(pixels);
+}
+
+TextureCache& TextureCache::instance() {
+    static TextureCache cache;
+    return cache;
+}
+
+std::unique_ptr<TextureCache::DecodedImage> TextureCache::decode(const std::string& path) {
+    std::unique_ptr<DecodedImage> image(new DecodedImage());
+    int channels = 3;
+    image->pixels = stbi_load(path.c_str(), &image->width, &image->height, &channels, 3);
+    if (!image->pixels) return nullptr;
+    return image;
+}
+
+void TextureCache::upload(GLuint texture, const DecodedImage& image) {
+    glBindTexture(GL_TEXTURE_2D, texture);
+    // Lignes RGB non alignées sur 4 octets pour les largeurs quelconques
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, image.width, image.height, 0, GL_RGB, GL_UNSIGNED_BYTE, image.pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // Mipmaps générés une seule fois, à l'envoi
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+}
+
+GLuint TextureCache::acquire(const std::string& path, bool async) {
+    // Chemins équivalents (relatif / absolu) ramenés à la même clé
+    std::error_code error;
+    std::string key = std::filesystem::weakly_canonical(path, error).string();
+    if (error) key = path;
+    int64_t modificationTime = static_cast<int64_t>(std::filesystem::last_write_time(key, error).time_since_epoch().count());
+    if (error) {
+        std::cerr << "Failed to load texture: " << path << std::endl;
+        return 0;
+    }
+
+    // Fichier déjà chargé et inchangé : texture partagée
+    auto found = textureByPath.find(key);
+    if (found != textureByPath.end()) {
+        Entry& entry = entries[found->second];
+        if (entry.modificationTime == modificationTime) {
+            ++entry.refCount;
+            return entry.texture;
+        }
+    }
+
+    std::unique_ptr<DecodedImage> image;
+    if (!async) {
+        image = decode(key);
+        if (!image) {
+            std::cerr << "Failed to load texture: " << path << std::endl;
+            return 0;
+        }
+    }
+
+    GLuint texture;
+    glGenTextures(1, &texture);
+    if (image) {
+        upload(texture, *image);
+    } else {
+        // Texture provisoire complète (sans mipmaps) en attendant le décodage
+        const unsigned char white[3] = {255, 255, 255};
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, white);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+
+    // Une ancienne version du fichier reste valide pour ceux qui la détiennent encore
+    Entry& entry = entries[texture];
+    entry.path = key;
+    entry.modificationTime = modificationTime;
+    entry.texture = texture;
+    entry.refCount = 1;
+    if (async) {
+        entry.pendingDecode = std::async(std::launch::async, [key]() { return decode(key); });
+    }
+    textureByPath[key] = texture;
+    return texture;
+}
+
+void TextureCache::release(GLuint texture) {
+    auto found = entries.find(texture);
+    if (found == entries.end()) return;
+
+    Entry& entry = found->second;
+    if (--entry.refCount > 0) return;
+
+    auto byPath = textureByPath.find(entry.path);
+    if (byPath != textureByPath.end() && byPath->second == texture) textureByPath.erase(byPath);
+    glDeleteTextures(1, &entry.texture);
+    // Le destructeur du future attendrait la fin du décodage : il est gardé jusqu'à ce qu'update() le trouve terminé
+    if (entry.pendingDecode.valid()) abandonedDecodes.push_back(std::move(entry.pendingDecode));
+    entries.erase(found);
+}
+
+void TextureCache::update() {
+    abandonedDecodes.erase(std::remove_if(abandonedDecodes.begin(), abandonedDecodes.end(),
+        [](const std::future<std::unique_ptr<DecodedImage>>& decode) {
+            return decode.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }), abandonedDecodes.end());
+
+    for (auto& item : entries) {
+        Entry& entry = item.second;
+        if (!entry.pendingDecode.valid()
+            || entry.pendingDecode.wait_for(std::chrono::seconds(0)) != std::future_status::ready) continue;
+
+        std::unique_ptr<DecodedImage> image = entry.pendingDecode.get();
+        if (image) {
+            upload(entry.texture, *image);
+        } else {
+            std::cerr << "Failed to load texture: " << entry.path << std::endl;
+        }
+    }
+}
+
+bool TextureCache::isPending(GLuint texture) const {
+    auto found = entries.find(texture);
+    return found != entries.end() && found->second.pendingDecode.valid();
+}
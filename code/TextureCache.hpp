@@ -0,0 +1,62 @@
+#ifndef TEXTURE_CACHE_HPP__
+#define TEXTURE_CACHE_HPP__
+
+#include <GL/glew.h>
+#include <string>
+#include <memory>
+#include <future>
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+
+// Textures partagées entre GameObjects, indexées par chemin et date de modification.
+// Une texture demandée plusieurs fois n'est décodée et envoyée qu'une seule fois ;
+// elle est détruite quand le dernier utilisateur la libère.
+class TextureCache {
+private:
+    struct DecodedImage {
+        int width = 0;
+        int height = 0;
+        unsigned char* pixels = nullptr;    // RGB, libéré par stbi_image_free
+        ~DecodedImage();
+    };
+
+    struct Entry {
+        std::string path;
+        int64_t modificationTime = 0;
+        GLuint texture = 0;
+        int refCount = 0;
+        std::future<std::unique_ptr<DecodedImage>> pendingDecode;
+    };
+
+    std::unordered_map<std::string, GLuint> textureByPath;  // Dernière version de chaque fichier
+    std::unordered_map<GLuint, Entry> entries;
+    std::vector<std::future<std::unique_ptr<DecodedImage>>> abandonedDecodes;  // Textures libérées pendant leur décodage
+
+    TextureCache() {}
+    GLuint acquire(const std::string& path, bool async);
+    static std::unique_ptr<DecodedImage> decode(const std::string& path);
+    static void upload(GLuint texture, const DecodedImage& image);
+
+public:
+    static TextureCache& instance();
+
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    // Décodage immédiat sur le thread appelant (thread de rendu)
+    GLuint acquire(const std::string& path) { return acquire(path, false); }
+    // Renvoie tout de suite une texture provisoire (1 pixel blanc), remplie par update()
+    // une fois l'image décodée sur un thread de travail
+    GLuint acquireAsync(const std::string& path) { return acquire(path, true); }
+    // Sans effet pour une texture qui ne vient pas du cache
+    void release(GLuint texture);
+
+    // À appeler une fois par frame sur le thread de rendu : envoi des images décodées
+    void update();
+
+    size_t getTextureCount() const { return entries.size(); }
+    bool isPending(GLuint texture) const;
+};
+
+#endif
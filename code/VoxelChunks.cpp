@@ -0,0 +1,159 @@
+#include "VoxelChunks.hpp"
+#include "Grid.hpp"
+
+VoxelChunks::~VoxelChunks() {
+    if (pendingBuild.valid()) pendingBuild.wait();
+    deleteBuffers();
+}
+
+void VoxelChunks::deleteBuffers() {
+    for (Chunk& chunk : chunks) {
+        if (chunk.VAO != 0) {
+            glDeleteVertexArrays(1, &chunk.VAO);
+            glDeleteBuffers(1, &chunk.VBO);
+        }
+    }
+}
+
+void VoxelChunks::reset(const glm::ivec3& size) {
+    // Un résultat en cours correspondrait à l'ancien découpage
+    if (pendingBuild.valid()) pendingBuild.wait();
+    pendingBuild = std::future<std::vector<ChunkResult>>();
+    deleteBuffers();
+    state.clear();
+    changedVoxels.clear();
+
+    gridSize = size;
+    chunkCount = (size + glm::ivec3(CHUNK_SIZE - 1)) / CHUNK_SIZE;
+    chunks.assign(static_cast<size_t>(chunkCount.x) * chunkCount.y * chunkCount.z, Chunk());
+    size_t index = 0;
+    for (int cx = 0; cx < chunkCount.x; ++cx) {
+        for (int cy = 0; cy < chunkCount.y; ++cy) {
+            for (int cz = 0; cz < chunkCount.z; ++cz) {
+                Chunk& chunk = chunks[index++];
+                chunk.origin = glm::ivec3(cx, cy, cz) * CHUNK_SIZE;
+                chunk.size = glm::min(glm::ivec3(CHUNK_SIZE), gridSize - chunk.origin);
+            }
+        }
+    }
+    voxelCount = 0;
+    culledCount = 0;
+}
+
+void VoxelChunks::markDirty(size_t voxelIndex) {
+    if (chunks.empty()) return;
+    int z = static_cast<int>(voxelIndex % gridSize.z);
+    int y = static_cast<int>((voxelIndex / gridSize.z) % gridSize.y);
+    int x = static_cast<int>(voxelIndex / (static_cast<size_t>(gridSize.y) * gridSize.z));
+    glm::ivec3 c = glm::ivec3(x, y, z) / CHUNK_SIZE;
+    chunks[(static_cast<size_t>(c.x) * chunkCount.y + c.y) * chunkCount.z + c.z].dirty = true;
+    changedVoxels.push_back(voxelIndex);
+}
+
+uint8_t VoxelChunks::voxelState(const VoxelData& voxel) {
+    return static_cast<uint8_t>((voxel.isEmpty == 0 ? 0x80 : 0) | (voxel.isSelected ? 0x40 : 0) | (voxel.faceMask & VOXEL_ALL_FACES));
+}
+
+std::vector<VoxelChunks::ChunkResult> VoxelChunks::buildChunks(std::vector<ChunkJob> jobs, glm::ivec3 gridSize,
+                                                               const std::vector<uint8_t>* state) {
+    std::vector<ChunkResult> results(jobs.size());
+    for (size_t j = 0; j < jobs.size(); ++j) {
+        const ChunkJob& job = jobs[j];
+        ChunkResult& result = results[j];
+        result.chunk = job.chunk;
+        for (int x = 0; x < job.size.x; ++x) {
+            for (int y = 0; y < job.size.y; ++y) {
+                size_t row = (static_cast<size_t>(job.origin.x + x) * gridSize.y + job.origin.y + y) * gridSize.z + job.origin.z;
+                for (int z = 0; z < job.size.z; ++z) {
+                    uint8_t voxel = (*state)[row + z];
+                    bool filled = voxel & 0x80;
+                    bool selected = voxel & 0x40;
+                    int faceMask = voxel & VOXEL_ALL_FACES;
+                    // Mêmes voxels que Grid::isInstanceVisible, coordonnées relatives au bloc
+                    if ((filled && faceMask != 0) || selected) {
+                        result.records.push_back(packVoxelRecord(x, y, z, selected ? VOXEL_ALL_FACES : faceMask, selected));
+                    }
+                }
+            }
+        }
+    }
+    return results;
+}
+
+void VoxelChunks::uploadChunk(Chunk& chunk, const std::vector<uint32_t>& records) {
+    if (chunk.VAO == 0) {
+        glGenVertexArrays(1, &chunk.VAO);
+        glGenBuffers(1, &chunk.VBO);
+        glBindVertexArray(chunk.VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, chunk.VBO);
+        glEnableVertexAttribArray(0);
+        glVertexAttribIPointer(0, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (void*)0);
+        glVertexAttribDivisor(0, 1);
+        glBindVertexArray(0);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, chunk.VBO);
+    if (records.size() > chunk.capacity) {
+        chunk.capacity = records.size() + records.size() / 2;
+        glBufferData(GL_ARRAY_BUFFER, chunk.capacity * sizeof(uint32_t), nullptr, GL_DYNAMIC_DRAW);
+    }
+    if (!records.empty()) {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, records.size() * sizeof(uint32_t), records.data());
+    }
+    voxelCount = voxelCount - chunk.count + records.size();
+    chunk.count = records.size();
+}
+
+void VoxelChunks::update(const std::vector<VoxelData>& voxels) {
+    if (chunks.empty()) return;
+
+    // Blocs terminés : envoyés tels quels, même s'ils ont été modifiés depuis (ils seront relancés)
+    if (pendingBuild.valid()) {
+        if (pendingBuild.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+        for (const ChunkResult& result : pendingBuild.get()) {
+            uploadChunk(chunks[result.chunk], result.records);
+        }
+    }
+
+    // Plus aucune lecture de state sur le thread de travail : seuls les voxels signalés sont recopiés
+    if (state.size() != voxels.size()) {
+        state.resize(voxels.size());
+        for (size_t i = 0; i < voxels.size(); ++i) state[i] = voxelState(voxels[i]);
+    } else {
+        for (size_t index : changedVoxels) state[index] = voxelState(voxels[index]);
+    }
+    changedVoxels.clear();
+
+    std::vector<ChunkJob> jobs;
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        Chunk& chunk = chunks[c];
+        if (!chunk.dirty) continue;
+        chunk.dirty = false;
+        jobs.push_back({c, chunk.origin, chunk.size});
+    }
+    if (!jobs.empty()) {
+        pendingBuild = std::async(std::launch::async, buildChunks, std::move(jobs), gridSize, &state);
+    }
+}
+
+void VoxelChunks::cull(const Frustum& frustum, const glm::vec3& minBounds, float voxelSize) {
+    culledCount = 0;
+    for (Chunk& chunk : chunks) {
+        glm::vec3 chunkMin = minBounds + glm::vec3(chunk.origin) * voxelSize;
+        glm::vec3 chunkMax = chunkMin + glm::vec3(chunk.size) * voxelSize;
+        chunk.visible = frustum.intersectsBox(chunkMin, chunkMax);
+        if (!chunk.visible && chunk.count > 0) ++culledCount;
+    }
+}
+
+void VoxelChunks::draw(const Shader& shader, const glm::vec3& minBounds, float voxelSize) {
+    GLint originLoc = shader.getUniformLocation("gridOrigin");
+    for (const Chunk& chunk : chunks) {
+        if (chunk.count == 0 || !chunk.visible) continue;
+        glm::vec3 origin = minBounds + glm::vec3(chunk.origin) * voxelSize;
+        glUniform3fv(originLoc, 1, &origin[0]);
+        glBindVertexArray(chunk.VAO);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 36, static_cast<GLsizei>(chunk.count));
+    }
+    glBindVertexArray(0);
+}
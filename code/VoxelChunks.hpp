@@ -0,0 +1,84 @@
+#ifndef VOXEL_CHUNKS_HPP__
+#define VOXEL_CHUNKS_HPP__
+
+#include <vector>
+#include <future>
+#include <cstdint>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "Shader.hpp"
+#include "Frustum.hpp"
+
+struct VoxelData;
+
+// Rendu d'une grille régulière (indices x * Y * Z + y * Z + z) par blocs de CHUNK_SIZE³ voxels.
+// Chaque bloc a son propre VBO de voxels compactés (voxel_packed_vertex_shader.glsl) et un
+// indicateur de modification : seuls les blocs modifiés sont reconstruits, sur un thread de
+// travail, puis envoyés au GPU par update() en début de frame.
+// Le thread de travail lit une copie d'un octet par voxel, tenue à jour par update() à partir
+// des seuls voxels signalés par markDirty (copie complète une fois, après reset()).
+class VoxelChunks {
+public:
+    static const int CHUNK_SIZE = 32;
+
+private:
+    struct Chunk {
+        glm::ivec3 origin;          // Premier voxel du bloc dans la grille
+        glm::ivec3 size;            // CHUNK_SIZE sauf au bord de la grille
+        GLuint VAO = 0, VBO = 0;
+        size_t capacity = 0;        // Voxels alloués dans VBO
+        size_t count = 0;           // Voxels affichés
+        bool dirty = true;          // Modifié depuis le dernier lancement de reconstruction
+        bool visible = true;        // Dans le champ de la caméra
+    };
+
+    struct ChunkJob {
+        size_t chunk;
+        glm::ivec3 origin;
+        glm::ivec3 size;
+    };
+    struct ChunkResult {
+        size_t chunk;
+        std::vector<uint32_t> records;
+    };
+
+    glm::ivec3 gridSize {0};
+    glm::ivec3 chunkCount {0};
+    std::vector<Chunk> chunks;
+    // État de chaque voxel : bit 7 plein, bit 6 sélectionné, bits 0-5 faceMask.
+    // Lu par le thread de travail, modifié par update() uniquement quand aucune reconstruction n'est en cours
+    std::vector<uint8_t> state;
+    std::vector<size_t> changedVoxels;                      // Signalés depuis la dernière mise à jour de state
+    std::future<std::vector<ChunkResult>> pendingBuild;    // Une seule reconstruction en cours
+    size_t voxelCount = 0;
+    size_t culledCount = 0;
+
+    static uint8_t voxelState(const VoxelData& voxel);
+    static std::vector<ChunkResult> buildChunks(std::vector<ChunkJob> jobs, glm::ivec3 gridSize, const std::vector<uint8_t>* state);
+    void uploadChunk(Chunk& chunk, const std::vector<uint32_t>& records);
+    void deleteBuffers();
+
+public:
+    VoxelChunks() {}
+    VoxelChunks(const VoxelChunks&) = delete;
+    VoxelChunks& operator=(const VoxelChunks&) = delete;
+
+    // Nouveau découpage, tous les blocs à reconstruire
+    void reset(const glm::ivec3& gridSize);
+    void markDirty(size_t voxelIndex);
+
+    // Début de frame : envoi des blocs reconstruits, copie des voxels signalés, puis lancement des blocs modifiés
+    void update(const std::vector<VoxelData>& voxels);
+    // Plans dans l'espace de la grille (projection * view * model)
+    void cull(const Frustum& frustum, const glm::vec3& minBounds, float voxelSize);
+    void draw(const Shader& shader, const glm::vec3& minBounds, float voxelSize);
+
+    bool isEmpty() const { return chunks.empty(); }
+    size_t getChunkCount() const { return chunks.size(); }
+    size_t getVoxelCount() const { return voxelCount; }
+    size_t getCulledCount() const { return culledCount; }
+
+    ~VoxelChunks();
+};
+
+#endif
@@ -0,0 +1,224 @@
+#include "VoxelGridFile.hpp"
+#include "RegularGrid.hpp"
+#include "AdaptativeGrid.hpp"
+#include "MappedFile.hpp"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+namespace {
+    const char GRID_MAGIC[4] = {'V', 'X', 'G', 'D'};
+    const uint32_t GRID_VERSION = 1;
+    static_assert(sizeof(VoxelGridFile::Header) == 80, "L'en-tête de grille doit rester sans remplissage");
+
+    const uint32_t MAX_RUN = std::numeric_limits<uint16_t>::max();
+    const int MAX_GRID_SIZE = 4096;    // Voxels par axe acceptés au chargement
+
+    // Plages alternées vide / plein le long de z, colonne (x, y) par colonne.
+    // Une plage trop longue est coupée par une plage nulle de l'autre état.
+    void encodeColumnRuns(const OccupancyGrid& occupancy, std::vector<uint16_t>& runs) {
+        runs.clear();
+        for (int x = 0; x < occupancy.size.x; ++x) {
+            for (int y = 0; y < occupancy.size.y; ++y) {
+                bool filled = false;
+                int z = 0;
+                while (z < occupancy.size.z) {
+                    int end = z;
+                    while (end < occupancy.size.z && occupancy.get(x, y, end) == filled) ++end;
+
+                    uint32_t length = end - z;
+                    while (length > MAX_RUN) {
+                        runs.push_back(static_cast<uint16_t>(MAX_RUN));
+                        runs.push_back(0);
+                        length -= MAX_RUN;
+                    }
+                    runs.push_back(static_cast<uint16_t>(length));
+                    z = end;
+                    filled = !filled;
+                }
+            }
+        }
+    }
+
+    bool decodeColumnRuns(const uint16_t* runs, uint64_t runCount, OccupancyGrid& occupancy) {
+        uint64_t r = 0;
+        for (int x = 0; x < occupancy.size.x; ++x) {
+            for (int y = 0; y < occupancy.size.y; ++y) {
+                bool filled = false;
+                size_t i = occupancy.index(x, y, 0);
+                size_t columnEnd = i + occupancy.size.z;
+                while (i < columnEnd) {
+                    if (r >= runCount) return false;
+                    uint16_t length;
+                    std::memcpy(&length, runs + r++, sizeof(length));
+                    if (i + length > columnEnd) return false;
+                    if (filled) {
+                        for (size_t end = i + length; i < end; ++i) occupancy.bits[i >> 6] |= 1ull << (i & 63);
+                    } else {
+                        i += length;
+                    }
+                    filled = !filled;
+                }
+            }
+        }
+        return r == runCount;
+    }
+
+    uint64_t countFilled(const OccupancyGrid& occupancy) {
+        uint64_t count = 0;
+        for (uint64_t word : occupancy.bits) {
+            for (; word; word &= word - 1) ++count;
+        }
+        return count;
+    }
+}
+
+bool VoxelGridFile::save(const std::string& filename, const Grid& grid) {
+    Header header = {};
+    std::copy(GRID_MAGIC, GRID_MAGIC + 4, header.magic);
+    header.version = GRID_VERSION;
+    header.method = static_cast<uint32_t>(grid.getMethod());
+    header.resolution = grid.getResolution();
+    header.minBounds = grid.getMinBounds();
+    header.maxBounds = grid.getMaxBounds();
+
+    std::vector<uint16_t> runs;
+    std::vector<uint8_t> octreeCodes;
+    OccupancyGrid occupancy;
+    const char* payload = nullptr;
+    size_t payloadBytes = 0;
+
+    if (const RegularGrid* regularGrid = dynamic_cast<const RegularGrid*>(&grid)) {
+        occupancy = regularGrid->getOccupancy();
+        header.gridKind = Regular;
+        header.size = occupancy.size;
+        header.voxelSize = occupancy.voxelSize;
+        header.filledCount = countFilled(occupancy);
+
+        // Les plages ne gagnent que sur des colonnes peu morcelées
+        encodeColumnRuns(occupancy, runs);
+        if (runs.size() * sizeof(uint16_t) <= occupancy.bits.size() * sizeof(uint64_t)) {
+            header.encoding = ColumnRuns;
+            header.payloadCount = runs.size();
+            payload = reinterpret_cast<const char*>(runs.data());
+            payloadBytes = runs.size() * sizeof(uint16_t);
+        } else {
+            header.encoding = PackedBits;
+            header.payloadCount = occupancy.bits.size();
+            payload = reinterpret_cast<const char*>(occupancy.bits.data());
+            payloadBytes = occupancy.bits.size() * sizeof(uint64_t);
+        }
+    } else if (const AdaptativeGrid* adaptativeGrid = dynamic_cast<const AdaptativeGrid*>(&grid)) {
+        header.gridKind = Adaptative;
+        header.encoding = LinearOctree;
+        adaptativeGrid->serializeOctree(octreeCodes, header.payloadCount);
+        for (uint64_t n = 0; n < header.payloadCount; ++n) {
+            if (((octreeCodes[n >> 2] >> ((n & 3) * 2)) & 3) == 1) ++header.filledCount;
+        }
+        payload = reinterpret_cast<const char*>(octreeCodes.data());
+        payloadBytes = octreeCodes.size();
+    } else {
+        std::cerr << "Erreur : type de grille non pris en charge par le format .vxg." << std::endl;
+        return false;
+    }
+
+    std::ofstream outFile(filename, std::ios::binary);
+    if (!outFile) {
+        std::cerr << "Erreur : impossible d'ouvrir le fichier pour écrire la grille." << std::endl;
+        return false;
+    }
+    outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    outFile.write(payload, payloadBytes);
+    if (!outFile) {
+        std::cerr << "Erreur : écriture incomplète de " << filename << std::endl;
+        return false;
+    }
+
+    std::cout << "Grille exportée : " << filename << " (" << sizeof(header) + payloadBytes << " octets, "
+              << header.filledCount << " voxels pleins)" << std::endl;
+    return true;
+}
+
+std::unique_ptr<Grid> VoxelGridFile::load(const std::string& filename, bool uploadBuffers) {
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        std::cerr << "Erreur : impossible d'ouvrir le fichier de grille " << filename << std::endl;
+        return nullptr;
+    }
+
+    Header header;
+    if (file.getSize() < sizeof(header)) {
+        std::cerr << "Erreur : " << filename << " n'est pas un fichier de grille valide." << std::endl;
+        return nullptr;
+    }
+    std::memcpy(&header, file.getData(), sizeof(header));
+    if (!std::equal(header.magic, header.magic + 4, GRID_MAGIC) || header.version != GRID_VERSION
+        || header.method > static_cast<uint32_t>(VoxelizationMethod::Surface)) {
+        std::cerr << "Erreur : " << filename << " n'est pas un fichier de grille valide." << std::endl;
+        return nullptr;
+    }
+
+    const char* payload = file.getData() + sizeof(header);
+    size_t payloadBytes = file.getSize() - sizeof(header);
+    VoxelizationMethod method = static_cast<VoxelizationMethod>(header.method);
+
+    if (header.gridKind == Regular) {
+        // Un VoxelData par cellule une fois restaurée : le total est borné avant toute allocation
+        uint64_t voxelCount = static_cast<uint64_t>(header.size.x) * header.size.y * header.size.z;
+        if (glm::any(glm::lessThanEqual(header.size, glm::ivec3(0)))
+            || glm::any(glm::greaterThan(header.size, glm::ivec3(MAX_GRID_SIZE)))
+            || voxelCount > RegularGrid::MAX_VOXEL_COUNT) {
+            std::cerr << "Erreur : dimensions de grille invalides dans " << filename << std::endl;
+            return nullptr;
+        }
+
+        // Avant d'allouer l'occupation : le nombre de voxels annoncé doit tenir dans les données présentes
+        bool consistent = false;
+        if (header.encoding == ColumnRuns) {
+            // Au moins une plage par colonne, au plus MAX_RUN voxels par plage
+            consistent = header.payloadCount <= payloadBytes / sizeof(uint16_t)
+                && static_cast<uint64_t>(header.size.x) * header.size.y <= header.payloadCount
+                && voxelCount <= header.payloadCount * MAX_RUN;
+        } else if (header.encoding == PackedBits) {
+            consistent = header.payloadCount == (voxelCount + 63) / 64
+                && header.payloadCount <= payloadBytes / sizeof(uint64_t);
+        }
+        if (!consistent) {
+            std::cerr << "Erreur : occupation tronquée ou encodage inconnu dans " << filename << std::endl;
+            return nullptr;
+        }
+        OccupancyGrid occupancy(header.size, header.minBounds, header.voxelSize);
+
+        bool decoded = true;
+        if (header.encoding == ColumnRuns) {
+            decoded = decodeColumnRuns(reinterpret_cast<const uint16_t*>(payload), header.payloadCount, occupancy);
+        } else {
+            std::memcpy(occupancy.bits.data(), payload, header.payloadCount * sizeof(uint64_t));
+        }
+        if (!decoded) {
+            std::cerr << "Erreur : occupation corrompue dans " << filename << std::endl;
+            return nullptr;
+        }
+
+        auto grid = std::make_unique<RegularGrid>();
+        if (!grid->restore(header.minBounds, header.maxBounds, header.resolution, method, occupancy, uploadBuffers)) return nullptr;
+        std::cout << "Grille chargée : " << filename << " (" << header.filledCount << " voxels pleins)" << std::endl;
+        return grid;
+    }
+
+    if (header.gridKind == Adaptative && header.encoding == LinearOctree) {
+        if (payloadBytes < (header.payloadCount + 3) / 4) {
+            std::cerr << "Erreur : octree tronqué dans " << filename << std::endl;
+            return nullptr;
+        }
+        auto grid = std::make_unique<AdaptativeGrid>();
+        if (!grid->restore(header.minBounds, header.maxBounds, header.resolution, method,
+                           reinterpret_cast<const uint8_t*>(payload), header.payloadCount, uploadBuffers)) return nullptr;
+        std::cout << "Grille chargée : " << filename << " (" << header.filledCount << " feuilles pleines)" << std::endl;
+        return grid;
+    }
+
+    std::cerr << "Erreur : type de grille inconnu dans " << filename << std::endl;
+    return nullptr;
+}
@@ -0,0 +1,42 @@
+#ifndef VOXEL_GRID_FILE_HPP__
+#define VOXEL_GRID_FILE_HPP__
+
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "Grid.hpp"
+
+// Fichier binaire d'une voxelisation (.vxg), relu par projection mémoire.
+// Après l'en-tête, selon le type de grille :
+//  - grille régulière : occupation colonne par colonne le long de z, soit en
+//    plages alternées vide / plein (uint16, chaque colonne commence par une plage
+//    vide éventuellement nulle), soit en bits bruts (uint64) si c'est plus petit ;
+//  - grille adaptative : octree linéaire en pré-ordre, 2 bits par nœud.
+class VoxelGridFile {
+public:
+    enum GridKind : uint32_t { Regular = 0, Adaptative = 1 };
+    enum Encoding : uint32_t { ColumnRuns = 0, PackedBits = 1, LinearOctree = 2 };
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t gridKind;
+        uint32_t encoding;
+        uint32_t method;
+        int32_t resolution;
+        glm::ivec3 size;            // Dimensions de la grille régulière (0 pour l'octree)
+        glm::vec3 minBounds;
+        glm::vec3 maxBounds;
+        float voxelSize;
+        uint64_t payloadCount;      // Plages, mots de 64 bits ou nœuds selon l'encodage
+        uint64_t filledCount;       // Voxels (ou feuilles) pleins
+    };
+
+    static bool save(const std::string& filename, const Grid& grid);
+    // Sans uploadBuffers, chargement sans appel OpenGL (thread de travail) :
+    // initializeBuffers() est alors à appeler sur le thread de rendu
+    static std::unique_ptr<Grid> load(const std::string& filename, bool uploadBuffers = true);
+};
+
+#endif
@@ -0,0 +1,45 @@
+#version 330 core
+
+uniform sampler2D gameObjectTexture;
+uniform int textureID;  // Commun au groupe d'objets dessiné
+
+in vec2 TexCoord;
+in vec3 FragPos;   // Position du fragment depuis le vertex shader
+in vec3 Normal;    // Normale du fragment depuis le vertex shader
+flat in vec4 objectColor;
+flat in vec4 materialAmbient;  // xyz : ambiant, w : brillance
+flat in vec3 materialDiffuse;
+flat in vec3 materialSpecular;
+
+// Données de la frame, partagées par tous les shaders (FrameUniforms)
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;       // Position de la caméra dans l'espace monde
+    vec4 lightPos;      // Position de la lumière dans l'espace monde
+    vec4 lightColor;    // Couleur de la lumière
+};
+
+out vec4 fragColor;
+
+// Même éclairage de Phong que fragment_shader.glsl, matériau lu par objet
+void main() {
+    vec3 ambient = lightColor.rgb * materialAmbient.xyz;
+
+    vec3 norm = normalize(Normal);
+    vec3 lightDir = normalize(lightPos.xyz - FragPos);
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = diff * lightColor.rgb * materialDiffuse;
+
+    vec3 viewDir = normalize(viewPos.xyz - FragPos);
+    vec3 reflectDir = reflect(-lightDir, norm);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), materialAmbient.w);
+    vec3 specular = spec * lightColor.rgb * materialSpecular;
+
+    vec3 phong = ambient + diffuse + specular;
+
+    if (textureID == 0)
+        fragColor = vec4(phong * objectColor.rgb, 1.0);
+    else
+        fragColor = vec4(phong, 1.0) * texture(gameObjectTexture, TexCoord);
+}
@@ -0,0 +1,51 @@
+#version 330 core
+
+layout(location = 0) in vec3 vertices_position_modelspace;
+layout(location = 1) in vec2 textureCoordinates;
+layout(location = 2) in vec2 normal_octahedral; // Normale encodée en octaèdre (PackedVertex)
+layout(location = 3) in uint drawID;            // Indice de l'objet dans objectData (BatchRenderer)
+
+// Données de la frame, partagées par tous les shaders (FrameUniforms)
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;       // Position de la caméra dans l'espace monde
+    vec4 lightPos;      // Position de la lumière dans l'espace monde
+    vec4 lightColor;    // Couleur de la lumière
+};
+
+// 8 texels par objet : model (4 colonnes), couleur, ambiant + brillance, diffus, spéculaire
+uniform samplerBuffer objectData;
+
+out vec2 TexCoord; // UV
+out vec3 FragPos;  // Position du fragment
+out vec3 Normal;   // Normale du fragment
+flat out vec4 objectColor;
+flat out vec4 materialAmbient;  // xyz : ambiant, w : brillance
+flat out vec3 materialDiffuse;
+flat out vec3 materialSpecular;
+
+// Inverse de GameObject::encodeNormal
+vec3 decodeNormal(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) {
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(n);
+}
+
+void main() {
+    int base = int(drawID) * 8;
+    mat4 model = mat4(texelFetch(objectData, base), texelFetch(objectData, base + 1),
+                      texelFetch(objectData, base + 2), texelFetch(objectData, base + 3));
+    objectColor = texelFetch(objectData, base + 4);
+    materialAmbient = texelFetch(objectData, base + 5);
+    materialDiffuse = texelFetch(objectData, base + 6).xyz;
+    materialSpecular = texelFetch(objectData, base + 7).xyz;
+
+    FragPos = vec3(model * vec4(vertices_position_modelspace, 1.0));
+    Normal = mat3(transpose(inverse(model))) * decodeNormal(normal_octahedral);
+    TexCoord = textureCoordinates;
+
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
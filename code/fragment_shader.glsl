@@ -8,10 +8,16 @@ in vec2 TexCoord;
 in vec3 FragPos;   // Position du fragment depuis le vertex shader
 in vec3 Normal;    // Normale du fragment depuis le vertex shader
 
-// Uniformes pour la lumière et le matériau
-uniform vec3 lightPos;
-uniform vec3 viewPos;
-uniform vec3 lightColor;
+// Données de la frame, partagées par tous les shaders (FrameUniforms)
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;       // Position de la caméra dans l'espace monde
+    vec4 lightPos;      // Position de la lumière dans l'espace monde
+    vec4 lightColor;    // Couleur de la lumière
+};
+
+// Matériau
 
 struct Material {
     vec3 ambient;
@@ -26,19 +32,19 @@ out vec4 fragColor;
 
 void main() {
     // Propriétés de la lumière
-    vec3 ambient = lightColor * material.ambient;
+    vec3 ambient = lightColor.rgb * material.ambient;
 
     // Calcul de la lumière diffuse
     vec3 norm = normalize(Normal);
-    vec3 lightDir = normalize(lightPos - FragPos);
+    vec3 lightDir = normalize(lightPos.xyz - FragPos);
     float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = diff * lightColor * material.diffuse;
+    vec3 diffuse = diff * lightColor.rgb * material.diffuse;
 
     // Calcul de la lumière spéculaire
-    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 viewDir = normalize(viewPos.xyz - FragPos);
     vec3 reflectDir = reflect(-lightDir, norm);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-    vec3 specular = spec * lightColor * material.specular;
+    vec3 specular = spec * lightColor.rgb * material.specular;
 
     // Combinaison des composants
     vec3 phong = ambient + diffuse + specular;
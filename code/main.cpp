@@ -8,6 +8,10 @@
 #include "Interface.hpp"
 #include "SceneManager.hpp"
 #include "RegularGrid.hpp"
+#include "SceneSnapshot.hpp"
+
+const char* SCENE_SNAPSHOT_PATH = "../data/scene.snapshot";
+const char* ASSET_INDEX_PATH = "../data/assets.index";
 
 // /*******************************************************************************/
 int main( void )
@@ -77,12 +81,27 @@ int main( void )
     Shader shader = Shader("vertex_shader.glsl", "fragment_shader.glsl");
     Shader voxelShader = Shader("voxel_vertex_shader.glsl", "voxel_fragment_shader.glsl", "voxel_geometry_shader.glsl" );
     // Shader voxelShader = Shader("voxel_vertex_shader.glsl", "voxel_fragment_shader.glsl");
+    Shader voxelInstancedShader = Shader("voxel_instanced_vertex_shader.glsl", "voxel_fragment_shader.glsl");
+    Shader voxelPackedShader = Shader("voxel_packed_vertex_shader.glsl", "voxel_fragment_shader.glsl");
+    Shader batchShader = Shader("batch_vertex_shader.glsl", "batch_fragment_shader.glsl");
+    batchShader.use();
+    batchShader.setInt("gameObjectTexture", 0);
+    batchShader.setInt("objectData", BatchRenderer::OBJECT_DATA_UNIT);
+    FrameUniforms frameUniforms; // Caméra et lumière, partagées par les shaders
+    shader.use();
+    shader.setInt("gameObjectTexture", 0);
     SceneManager *SM = new SceneManager();
 
+    // Indexation des assets en arrière-plan (métadonnées pour les dialogues et les estimations)
+    AssetIndex::instance().startScan({"../data/meshes", "../data/textures"}, ASSET_INDEX_PATH);
 
-    Mesh *mesh = new Mesh("patate", "../data/meshes/sphere.off", glm::vec4(1.0f), shader);
-    mesh->setInitalTransform(mesh->getTransform());
-    SM->addObject(std::move(mesh->ptr));
+    // Reprise de la session précédente si un instantané existe, sinon scène par défaut
+    if (!SceneSnapshot::load(SCENE_SNAPSHOT_PATH, *SM, shader)) {
+        Mesh *mesh = new Mesh("patate", "../data/meshes/sphere.off", glm::vec4(1.0f), shader);
+        mesh->setInitalTransform(mesh->getTransform());
+        SM->addObject(std::move(mesh->ptr));
+        SM->initGameObjectsTexture();
+    }
 
    
     // RegularGrid grid = RegularGrid(mesh->getIndices(), mesh->getVertices(), 10);
@@ -92,7 +111,6 @@ int main( void )
     // mesh2->setInitalTransform(mesh2->getTransform());
     // SM->addObject(std::move(mesh2->ptr));
     
-    SM->initGameObjectsTexture();
     Interface interface(shader, SM, &camera); 
 
     // shader.use(); 
@@ -142,18 +160,28 @@ int main( void )
         interface.createFrame(); 
         interface.update(deltaTime, window); 
 
-        camera.setupEditorLight(shader.ID);
         camera.update(deltaTime, window); 
-        camera.sendToShader(shader.ID, aspectRatio);
+        camera.updateFrameUniforms(frameUniforms, aspectRatio);
 
         SM->update(deltaTime, window);
-        SM->draw(shader);
+        SM->cull(camera.getFrustum(aspectRatio));
+        // Meshes regroupés en quelques appels, ou un appel complet par objet
+        if (BatchRenderer::isEnabled()) {
+            batchShader.use();
+            SM->drawBatched(batchShader);
+        } else {
+            SM->draw(shader);
+        }
+
 
+        int framebufferWidth, framebufferHeight;
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+        SM->updateLOD(camera.getViewMatrix(), camera.getProjectionMatrix(aspectRatio), static_cast<float>(framebufferHeight));
 
-        voxelShader.use();
-        camera.sendToShader(voxelShader.ID, aspectRatio);
-        camera.setupEditorLight(voxelShader.ID);
-        SM->drawVoxel(voxelShader); 
+        // Cubes instanciés, ou points étendus par le geometry shader
+        // (voxels compactés des grilles régulières : vertex pulling)
+        Shader& activeVoxelShader = Grid::isInstancedRendering() ? voxelInstancedShader : voxelShader;
+        SM->drawVoxel(activeVoxelShader, voxelPackedShader); 
 
         interface.renderFrame();
 
@@ -168,6 +196,7 @@ int main( void )
           glfwWindowShouldClose(window) == 0 );
 
     interface.deleteFrame(); 
+    SceneSnapshot::save(SCENE_SNAPSHOT_PATH, *SM);
 
 
     // Close OpenGL window and terminate GLFW
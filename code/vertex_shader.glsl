@@ -2,18 +2,35 @@
 
 layout(location = 0) in vec3 vertices_position_modelspace;
 layout(location = 1) in vec2 textureCoordinates;
-layout(location = 2) in vec3 normal_modelspace; // Nouvelle entrée pour la normale
+layout(location = 2) in vec2 normal_octahedral; // Normale encodée en octaèdre (PackedVertex)
+
+// Données de la frame, partagées par tous les shaders (FrameUniforms)
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;       // Position de la caméra dans l'espace monde
+    vec4 lightPos;      // Position de la lumière dans l'espace monde
+    vec4 lightColor;    // Couleur de la lumière
+};
 
-uniform mat4 view;
-uniform mat4 projection;
 uniform mat4 model;
 
 out vec2 TexCoord; // UV
 out vec3 FragPos;  // Position du fragment
 out vec3 Normal;   // Normale du fragment
 
+// Inverse de GameObject::encodeNormal
+vec3 decodeNormal(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) {
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(n);
+}
+
 void main() {
     FragPos = vec3(model * vec4(vertices_position_modelspace, 1.0));
+    vec3 normal_modelspace = decodeNormal(normal_octahedral);
     Normal = mat3(transpose(inverse(model))) * normal_modelspace;
     TexCoord = textureCoordinates;
     
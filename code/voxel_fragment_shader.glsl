@@ -4,10 +4,15 @@
 in vec3 fNormal;          // Normale pour chaque face
 in vec3 fWorldPosition;   // Position dans l'espace monde
 
-// Uniformes pour l'éclairage
-uniform vec3 lightPos;    // Position de la lumière dans l'espace monde
-uniform vec3 viewPos;     // Position de la caméra dans l'espace monde
-uniform vec3 lightColor;  // Couleur de la lumière
+// Données de la frame, partagées par tous les shaders (FrameUniforms)
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;       // Position de la caméra dans l'espace monde
+    vec4 lightPos;      // Position de la lumière dans l'espace monde
+    vec4 lightColor;    // Couleur de la lumière
+};
+
 uniform vec3 objectColor; // Couleur de l'objet
 
 // Entrées depuis le Geometry Shader
@@ -20,22 +25,22 @@ out vec4 FragColor;
 void main() {
     // Normalisation des entrées
     vec3 norm = normalize(fNormal);
-    vec3 lightDir = normalize(lightPos - fWorldPosition);
-    vec3 viewDir = normalize(viewPos - fWorldPosition);
+    vec3 lightDir = normalize(lightPos.xyz - fWorldPosition);
+    vec3 viewDir = normalize(viewPos.xyz - fWorldPosition);
 
     // Calcul de l'éclairage ambient
     float ambientStrength = 0.1;
-    vec3 ambient = ambientStrength * lightColor;
+    vec3 ambient = ambientStrength * lightColor.rgb;
 
     // Calcul de l'éclairage diffus
     float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = diff * lightColor;
+    vec3 diffuse = diff * lightColor.rgb;
 
     // Calcul de l'éclairage spéculaire
     float specularStrength = 0.5;
     vec3 reflectDir = reflect(-lightDir, norm);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
-    vec3 specular = specularStrength * spec * lightColor;
+    vec3 specular = specularStrength * spec * lightColor.rgb;
 
     // Combinaison des résultats
     vec3 result = ((isSelected != 0 ? vec3(1.0, 0.0, 0.0) : ambient) + diffuse + specular) * objectColor;
@@ -9,6 +9,7 @@ in VS_OUT {
     float halfSize;   // Taille (demi-côté du voxel)
     int isEmpty;
     int isSelected;
+    int faceMask;
 } gs_in[];
 
 // Sorties pour le Fragment Shader
@@ -17,10 +18,16 @@ out vec3 fWorldPosition;   // Position dans l'espace monde (pour debug ou shadin
 out vec3 n;
 flat out int isSelected;  // Passer l'int (0 ou 1) au Fragment Shader
 
-// Uniformes pour les matrices
+// Données de la frame, partagées par tous les shaders (FrameUniforms)
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;       // Position de la caméra dans l'espace monde
+    vec4 lightPos;      // Position de la lumière dans l'espace monde
+    vec4 lightColor;    // Couleur de la lumière
+};
+
 uniform mat4 model;         // Matrice modèle
-uniform mat4 view;          // Matrice vue
-uniform mat4 projection;    // Matrice projection
 
 // Fonction pour émettre un sommet avec une normale
 void EmitVertexWithNormal(vec3 position, vec3 normal) {
@@ -64,8 +71,13 @@ void generateCube(vec3 _center, float _halfSize, int _isSelected) {
         3, 2, 7, 6   // Face dessus
     );
 
-    // Générer chaque face
+    // Bit de faceMask de chaque face (ordre -X, +X, -Y, +Y, -Z, +Z côté CPU)
+    int faceBits[6] = int[](4, 5, 0, 1, 2, 3);
+    int faceMask = (_isSelected != 0) ? 63 : gs_in[0].faceMask;
+
+    // Générer chaque face visible
     for (int face = 0; face < 6; ++face) {
+        if ((faceMask & (1 << faceBits[face])) == 0) continue;
         vec3 normal = normals[face];
 
         // Émettre les 4 sommets pour la face
@@ -0,0 +1,40 @@
+#version 330 core
+
+layout(location = 0) in vec3 inPosition;        // Sommet du cube unité, dans [-1, 1]
+layout(location = 1) in vec3 inNormal;          // Normale de la face
+layout(location = 2) in vec4 inCenterHalfSize;  // Par instance : centre du voxel (xyz) et demi-taille (w)
+layout(location = 3) in int inIsSelected;       // Par instance : voxel sélectionné ou pas
+layout(location = 4) in int inFaceMask;         // Par instance : faces visibles (bit i = face gl_VertexID / 6)
+
+// Données de la frame, partagées par tous les shaders (FrameUniforms)
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;       // Position de la caméra dans l'espace monde
+    vec4 lightPos;      // Position de la lumière dans l'espace monde
+    vec4 lightColor;    // Couleur de la lumière
+};
+
+uniform mat4 model;         // Matrice modèle
+
+// Sorties pour le Fragment Shader (mêmes noms que le Geometry Shader)
+out vec3 fNormal;
+out vec3 fWorldPosition;
+flat out int isSelected;
+
+void main() {
+    // Face collée à un voisin plein : triangles envoyés hors du volume de vue, éliminés au clipping
+    if ((inFaceMask & (1 << (gl_VertexID / 6))) == 0) {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        return;
+    }
+
+    // Comme avec le Geometry Shader : seul le centre suit la matrice modèle
+    vec3 worldCenter = (model * vec4(inCenterHalfSize.xyz, 1.0)).xyz;
+    vec3 position = worldCenter + inPosition * inCenterHalfSize.w;
+
+    fNormal = inNormal;
+    fWorldPosition = position;
+    isSelected = inIsSelected;
+    gl_Position = projection * view * vec4(position, 1.0);
+}
@@ -0,0 +1,57 @@
+#version 330 core
+
+layout(location = 0) in uint inPackedVoxel;    // Par instance : x, y, z dans le bloc sur 8 bits, faceMask (24-29), sélection (30)
+
+// Données de la frame, partagées par tous les shaders (FrameUniforms)
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;       // Position de la caméra dans l'espace monde
+    vec4 lightPos;      // Position de la lumière dans l'espace monde
+    vec4 lightColor;    // Couleur de la lumière
+};
+
+uniform mat4 model;         // Matrice modèle
+uniform vec3 gridOrigin;    // Coin minimal du bloc de voxels (VoxelChunks)
+uniform float voxelSize;    // Côté d'un voxel
+
+// Cube unité de Grid::uploadInstances, faces dans l'ordre des bits de faceMask
+const vec3 cubeVertices[36] = vec3[36](
+    vec3(-1, -1, -1), vec3(-1, -1,  1), vec3(-1,  1,  1), vec3(-1, -1, -1), vec3(-1,  1,  1), vec3(-1,  1, -1),
+    vec3( 1, -1, -1), vec3( 1,  1,  1), vec3( 1, -1,  1), vec3( 1, -1, -1), vec3( 1,  1, -1), vec3( 1,  1,  1),
+    vec3(-1, -1, -1), vec3( 1, -1, -1), vec3( 1, -1,  1), vec3(-1, -1, -1), vec3( 1, -1,  1), vec3(-1, -1,  1),
+    vec3(-1,  1, -1), vec3(-1,  1,  1), vec3( 1,  1,  1), vec3(-1,  1, -1), vec3( 1,  1,  1), vec3( 1,  1, -1),
+    vec3(-1, -1, -1), vec3( 1,  1, -1), vec3( 1, -1, -1), vec3(-1, -1, -1), vec3(-1,  1, -1), vec3( 1,  1, -1),
+    vec3(-1, -1,  1), vec3( 1, -1,  1), vec3( 1,  1,  1), vec3(-1, -1,  1), vec3( 1,  1,  1), vec3(-1,  1,  1)
+);
+
+// Sorties pour le Fragment Shader (mêmes noms que le Geometry Shader)
+out vec3 fNormal;
+out vec3 fWorldPosition;
+flat out int isSelected;
+
+void main() {
+    int face = gl_VertexID / 6;
+    int faceMask = int((inPackedVoxel >> 24u) & 63u);
+
+    // Face collée à un voisin plein : triangles envoyés hors du volume de vue, éliminés au clipping
+    if ((faceMask & (1 << face)) == 0) {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        return;
+    }
+
+    uvec3 coords = uvec3(inPackedVoxel, inPackedVoxel >> 8u, inPackedVoxel >> 16u) & 255u;
+    vec3 center = gridOrigin + (vec3(coords) + 0.5) * voxelSize;
+
+    // Comme avec le Geometry Shader : seul le centre suit la matrice modèle
+    vec3 worldCenter = (model * vec4(center, 1.0)).xyz;
+    vec3 position = worldCenter + cubeVertices[gl_VertexID] * (0.5 * voxelSize);
+
+    vec3 normal = vec3(0.0);
+    normal[face / 2] = (face % 2 == 1) ? 1.0 : -1.0;
+
+    fNormal = normal;
+    fWorldPosition = position;
+    isSelected = int((inPackedVoxel >> 30u) & 1u);
+    gl_Position = projection * view * vec4(position, 1.0);
+}
@@ -4,6 +4,7 @@ layout(location = 0) in vec3 inCenter;  // Le centre du voxel dans l'espace mod
 layout(location = 1) in float inHalfSize;  // La halfSize du voxel
 layout(location = 2) in int inIsEmpty;  // Est-ce que le voxel est plein ou pas
 layout(location = 3) in int inIsSelected;  // Est-ce que le voxel est sélectionné ou pas
+layout(location = 4) in int inFaceMask;  // Faces non collées à un voisin plein
 
 uniform mat4 model;
 
@@ -12,6 +13,7 @@ out VS_OUT {
     float halfSize;   // Taille du voxel, inchangée
     int isEmpty;
     int isSelected;
+    int faceMask;
 } vs_out;
 
 void main() {
@@ -20,6 +22,7 @@ void main() {
     vs_out.halfSize = inHalfSize;   // Taille, directement transmise
     vs_out.isEmpty = inIsEmpty;
     vs_out.isSelected = inIsSelected;
+    vs_out.faceMask = inFaceMask;
 
     // Calculer la position finale dans l'espace écran pour OpenGL
     // gl_Position = projection * view * vec4(FragPos, 1.0);
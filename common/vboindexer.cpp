@@ -1,11 +1,12 @@
 #include <vector>
-#include <map>
+#include <cmath>
+#include <cstring>
+#include <iostream>
 
 #include <glm/glm.hpp>
 
 #include "vboindexer.hpp"
 
-#include <string.h> // for memcmp
 
 
 // Returns true iif v1 can be considered equal to v2
@@ -74,30 +75,85 @@ void indexVBO_slow(
 	}
 }
 
-struct PackedVertex{
-	glm::vec3 position;
-	glm::vec2 uv;
-	glm::vec3 normal;
-	bool operator<(const PackedVertex that) const{
-		return memcmp((void*)this, (void*)&that, sizeof(PackedVertex))>0;
-	};
-};
-
-bool getSimilarVertexIndex_fast( 
-	PackedVertex & packed, 
-	std::map<PackedVertex,unsigned short> & VertexToOutIndex,
-	unsigned short & result
-){
-	std::map<PackedVertex,unsigned short>::iterator it = VertexToOutIndex.find(packed);
-	if ( it == VertexToOutIndex.end() ){
-		return false;
-	}else{
-		result = it->second;
-		return true;
+VertexWelder::VertexWelder(float epsilon, size_t expectedVertices)
+	: epsilon(epsilon), inverseEpsilon(epsilon > 0.0f ? 1.0f / epsilon : 0.0f)
+{
+	// Load factor kept under 1/2
+	size_t capacity = 16;
+	while ( capacity < expectedVertices * 2 )
+		capacity *= 2;
+	slots.assign(capacity, 0);
+	positions.reserve(expectedVertices);
+	uvs.reserve(expectedVertices);
+	normals.reserve(expectedVertices);
+}
+
+void VertexWelder::quantize(const glm::vec3 & position, const glm::vec2 & uv, const glm::vec3 & normal, int32_t out[8]) const {
+	float values[8] = { position.x, position.y, position.z, uv.x, uv.y, normal.x, normal.y, normal.z };
+	for ( int i=0; i<8; i++ ){
+		if ( epsilon > 0.0f ){
+			out[i] = (int32_t)std::floor( values[i] * inverseEpsilon );
+		}else{
+			// Exact comparison on the bit pattern, with -0 folded onto +0
+			float value = (values[i] == 0.0f) ? 0.0f : values[i];
+			memcpy(&out[i], &value, sizeof(float));
+		}
 	}
 }
 
-void indexVBO(
+uint64_t VertexWelder::hash(const int32_t key[8]) const {
+	uint64_t h = 1469598103934665603ull;
+	for ( int i=0; i<8; i++ ){
+		h ^= (uint32_t)key[i];
+		h *= 1099511628211ull;
+	}
+	return h ^ (h >> 29);
+}
+
+void VertexWelder::grow(){
+	std::vector<uint32_t> old;
+	old.swap(slots);
+	slots.assign(old.size() * 2, 0);
+	size_t mask = slots.size() - 1;
+
+	int32_t key[8];
+	for ( uint32_t slot : old ){
+		if ( slot == 0 )
+			continue;
+		quantize(positions[slot - 1], uvs[slot - 1], normals[slot - 1], key);
+		size_t i = hash(key) & mask;
+		while ( slots[i] != 0 )
+			i = (i + 1) & mask;
+		slots[i] = slot;
+	}
+}
+
+unsigned int VertexWelder::weld(const glm::vec3 & position, const glm::vec2 & uv, const glm::vec3 & normal){
+	if ( (positions.size() + 1) * 2 > slots.size() )
+		grow();
+
+	int32_t key[8], other[8];
+	quantize(position, uv, normal, key);
+	size_t mask = slots.size() - 1;
+	size_t i = hash(key) & mask;
+
+	// Linear probing until an equal vertex or an empty slot
+	while ( slots[i] != 0 ){
+		uint32_t index = slots[i] - 1;
+		quantize(positions[index], uvs[index], normals[index], other);
+		if ( memcmp(key, other, sizeof(key)) == 0 )
+			return index;
+		i = (i + 1) & mask;
+	}
+
+	positions.push_back(position);
+	uvs.push_back(uv);
+	normals.push_back(normal);
+	slots[i] = (uint32_t)positions.size();
+	return (unsigned int)positions.size() - 1;
+}
+
+bool indexVBO(
 	std::vector<glm::vec3> & in_vertices,
 	std::vector<glm::vec2> & in_uvs,
 	std::vector<glm::vec3> & in_normals,
@@ -107,29 +163,47 @@ void indexVBO(
 	std::vector<glm::vec2> & out_uvs,
 	std::vector<glm::vec3> & out_normals
 ){
-	std::map<PackedVertex,unsigned short> VertexToOutIndex;
+	std::vector<unsigned int> indices;
+	indexVBO(in_vertices, in_uvs, in_normals, indices, out_vertices, out_uvs, out_normals);
 
-	// For each input vertex
-	for ( unsigned int i=0; i<in_vertices.size(); i++ ){
+	if ( out_vertices.size() > 65536 ){
+		std::cerr << "indexVBO: " << out_vertices.size() << " vertices do not fit 16-bit indices, use the 32-bit overload" << std::endl;
+		out_vertices.clear();
+		out_uvs.clear();
+		out_normals.clear();
+		return false;
+	}
+	out_indices.reserve(out_indices.size() + indices.size());
+	for ( unsigned int index : indices )
+		out_indices.push_back( (unsigned short)index );
+	return true;
+}
 
-		PackedVertex packed = {in_vertices[i], in_uvs[i], in_normals[i]};
-		
+void indexVBO(
+	const std::vector<glm::vec3> & in_vertices,
+	const std::vector<glm::vec2> & in_uvs,
+	const std::vector<glm::vec3> & in_normals,
 
-		// Try to find a similar vertex in out_XXXX
-		unsigned short index;
-		bool found = getSimilarVertexIndex_fast( packed, VertexToOutIndex, index);
+	std::vector<unsigned int> & out_indices,
+	std::vector<glm::vec3> & out_vertices,
+	std::vector<glm::vec2> & out_uvs,
+	std::vector<glm::vec3> & out_normals,
+	float epsilon
+){
+	VertexWelder welder(epsilon, in_vertices.size() / 4);
 
-		if ( found ){ // A similar vertex is already in the VBO, use it instead !
-			out_indices.push_back( index );
-		}else{ // If not, it needs to be added in the output data.
-			out_vertices.push_back( in_vertices[i]);
-			out_uvs     .push_back( in_uvs[i]);
-			out_normals .push_back( in_normals[i]);
-			unsigned short newindex = (unsigned short)out_vertices.size() - 1;
-			out_indices .push_back( newindex );
-			VertexToOutIndex[ packed ] = newindex;
-		}
+	// For each input vertex, reuse an equal one already in the VBO if any
+	out_indices.reserve(out_indices.size() + in_vertices.size());
+	for ( size_t i=0; i<in_vertices.size(); i++ ){
+		out_indices.push_back( welder.weld(
+			in_vertices[i],
+			i < in_uvs.size() ? in_uvs[i] : glm::vec2(0.0f),
+			i < in_normals.size() ? in_normals[i] : glm::vec3(0.0f) ) );
 	}
+
+	out_vertices = std::move(welder.getPositions());
+	out_uvs = std::move(welder.getUVs());
+	out_normals = std::move(welder.getNormals());
 }
 
 
@@ -152,26 +226,32 @@ void indexVBO_TBN(
 	std::vector<glm::vec3> & out_tangents,
 	std::vector<glm::vec3> & out_bitangents
 ){
+	// Hashed 0.01 cells instead of the is_near linear search: vertices in the
+	// same cell are merged, close vertices across a cell boundary are not
+	VertexWelder welder(0.01f, in_vertices.size() / 4);
+	for ( size_t i=0; i<out_vertices.size(); i++ )
+		welder.weld(out_vertices[i], out_uvs[i], out_normals[i]);
+
 	// For each input vertex
 	for ( unsigned int i=0; i<in_vertices.size(); i++ ){
 
-		// Try to find a similar vertex in out_XXXX
-		unsigned short index;
-		bool found = getSimilarVertexIndex(in_vertices[i], in_uvs[i], in_normals[i],     out_vertices, out_uvs, out_normals, index);
+		size_t previousSize = welder.size();
+		unsigned short index = (unsigned short)welder.weld(in_vertices[i], in_uvs[i], in_normals[i]);
 
-		if ( found ){ // A similar vertex is already in the VBO, use it instead !
+		if ( welder.size() == previousSize ){ // A similar vertex is already in the VBO, use it instead !
 			out_indices.push_back( index );
 
 			// Average the tangents and the bitangents
 			out_tangents[index] += in_tangents[i];
 			out_bitangents[index] += in_bitangents[i];
 		}else{ // If not, it needs to be added in the output data.
-			out_vertices.push_back( in_vertices[i]);
-			out_uvs     .push_back( in_uvs[i]);
-			out_normals .push_back( in_normals[i]);
 			out_tangents .push_back( in_tangents[i]);
 			out_bitangents .push_back( in_bitangents[i]);
-			out_indices .push_back( (unsigned short)out_vertices.size() - 1 );
+			out_indices .push_back( index );
 		}
 	}
+
+	out_vertices = std::move(welder.getPositions());
+	out_uvs = std::move(welder.getUVs());
+	out_normals = std::move(welder.getNormals());
 }
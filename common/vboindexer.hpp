@@ -1,7 +1,44 @@
 #ifndef VBOINDEXER_HPP
 #define VBOINDEXER_HPP
 
-void indexVBO(
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// Open-addressing vertex welder (linear probing, power-of-two table).
+// With epsilon > 0, attributes are quantized to a grid of that step before
+// hashing and comparison: values falling in the same cell are merged (up to
+// epsilon apart), values on either side of a cell boundary stay distinct
+// however close they are. This is not a distance threshold.
+// Output indices are 32-bit.
+class VertexWelder {
+public:
+	explicit VertexWelder(float epsilon = 0.0f, size_t expectedVertices = 0);
+
+	// Returns the index of an equal vertex, adding it if it is new
+	unsigned int weld(const glm::vec3 & position, const glm::vec2 & uv = glm::vec2(0.0f), const glm::vec3 & normal = glm::vec3(0.0f));
+
+	size_t size() const { return positions.size(); }
+	std::vector<glm::vec3> & getPositions() { return positions; }
+	std::vector<glm::vec2> & getUVs() { return uvs; }
+	std::vector<glm::vec3> & getNormals() { return normals; }
+
+private:
+	float epsilon;
+	float inverseEpsilon;
+	std::vector<uint32_t> slots; // Output index + 1, 0 = empty
+	std::vector<glm::vec3> positions;
+	std::vector<glm::vec2> uvs;
+	std::vector<glm::vec3> normals;
+
+	void quantize(const glm::vec3 & position, const glm::vec2 & uv, const glm::vec3 & normal, int32_t out[8]) const;
+	uint64_t hash(const int32_t key[8]) const;
+	void grow();
+};
+
+// 16-bit variant: returns false, leaving out_indices untouched and the other
+// outputs empty, when the welded mesh has more than 65536 vertices
+bool indexVBO(
 	std::vector<glm::vec3> & in_vertices,
 	std::vector<glm::vec2> & in_uvs,
 	std::vector<glm::vec3> & in_normals,
@@ -12,6 +49,19 @@ void indexVBO(
 	std::vector<glm::vec3> & out_normals
 );
 
+// 32-bit variant, with optional welding tolerance
+void indexVBO(
+	const std::vector<glm::vec3> & in_vertices,
+	const std::vector<glm::vec2> & in_uvs,
+	const std::vector<glm::vec3> & in_normals,
+
+	std::vector<unsigned int> & out_indices,
+	std::vector<glm::vec3> & out_vertices,
+	std::vector<glm::vec2> & out_uvs,
+	std::vector<glm::vec3> & out_normals,
+	float epsilon = 0.0f
+);
+
 
 void indexVBO_TBN(
 	std::vector<glm::vec3> & in_vertices,
@@ -28,4 +78,4 @@ void indexVBO_TBN(
 	std::vector<glm::vec3> & out_bitangents
 );
 
-#endif
\ No newline at end of file
+#endif